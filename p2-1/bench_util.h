@@ -0,0 +1,213 @@
+/** @file bench_util.h */
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "doublely_linked_list.h"
+
+
+/********************************************
+ * Benchmark helpers                        *
+ * Timing, random numbers and reporting     *
+ * shared by the *_bench.cpp programs.      *
+ ********************************************/
+
+
+/**
+ * benchSeconds
+ *
+ * Return a monotonic timestamp in seconds
+ *
+ * @return the current time in seconds
+ */
+static inline double benchSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * benchRandom
+ *
+ * Return the next value of a xorshift64* generator
+ *
+ * @param state A pointer to the generator state. Must not be zero.
+ * @return a pseudo-random 64-bit value
+ */
+static inline uint64_t benchRandom(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545f4914f6cdd1dULL;
+}
+
+/**
+ * benchReport
+ *
+ * Print one result line: the benchmark name, operation rate and time per operation
+ *
+ * @param name The name of the benchmark
+ * @param ops The number of operations performed
+ * @param seconds The time the operations took
+ */
+static inline void benchReport(const char* name, double ops, double seconds) {
+    printf("%-44s %10.2f Mops/s %9.2f ns/op\n", name, ops / seconds / 1e6, seconds * 1e9 / ops);
+}
+
+/**
+ * benchDrain
+ *
+ * Remove every node from a list without freeing the data, which benchmarks
+ * borrow or fake, so the list can be destroyed
+ *
+ * @param list A pointer to the list
+ */
+static inline void benchDrain(DLinkedList* list) {
+    getHead(list);
+    while (getCurrent(list) != NULL) removeForward(list);
+}
+
+/**
+ * This structure is what benchRunThreads hands each thread.
+ */
+typedef struct benchthread_t {
+    /** The argument given to benchRunThreads */
+    void* arg;
+
+    /** This thread's index, from 0 to threads - 1 */
+    int index;
+
+    /** The number of threads running */
+    int threads;
+
+    /** Held until every thread is ready, so they start together */
+    pthread_barrier_t* start;
+
+    /** The function the thread runs */
+    void* (*body)(struct benchthread_t*);
+
+    /** When this thread was released and when its body returned */
+    double began, ended;
+} BenchThread;
+
+// Each thread takes its own timestamps, so a thread that finishes before the
+// main thread is scheduled again is still timed correctly
+static inline void* bench_thread_main(void* p) {
+    BenchThread* t = (BenchThread *) p;
+    pthread_barrier_wait(t->start);
+    t->began = benchSeconds();
+    void* result = t->body(t);
+    t->ended = benchSeconds();
+    return result;
+}
+
+/**
+ * benchRunThreads
+ *
+ * Run the body on the given number of threads, released together, and time
+ * them from release until the last one finishes
+ *
+ * @param threads The number of threads to run
+ * @param body The function each thread runs
+ * @param arg Passed to every thread through BenchThread.arg
+ * @return the elapsed time in seconds
+ */
+static inline double benchRunThreads(int threads, void* (*body)(BenchThread*), void* arg) {
+    pthread_t* ids = (pthread_t *) malloc(threads * sizeof(pthread_t));
+    BenchThread* info = (BenchThread *) malloc(threads * sizeof(BenchThread));
+    pthread_barrier_t start;
+    pthread_barrier_init(&start, NULL, threads + 1);
+    for (int i = 0; i < threads; i++) {
+        info[i].arg = arg;
+        info[i].body = body;
+        info[i].index = i;
+        info[i].threads = threads;
+        info[i].start = &start;
+        pthread_create(&ids[i], NULL, bench_thread_main, &info[i]);
+    }
+    pthread_barrier_wait(&start);
+    double begin = 0, end = 0;
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+        if (i == 0 || info[i].began < begin) begin = info[i].began;
+        if (i == 0 || info[i].ended > end) end = info[i].ended;
+    }
+    double seconds = end - begin;
+    pthread_barrier_destroy(&start);
+    free(ids);
+    free(info);
+    return seconds;
+}
+
+/**
+ * This structure represents a Zipf-distributed key generator over [0, n).
+ */
+typedef struct zipfgen_t {
+    /** Cumulative probability of each key, in key order */
+    double* cdf;
+
+    /** The number of keys */
+    size_t n;
+} ZipfGen;
+
+/**
+ * create_zipfgen
+ *
+ * Precompute the distribution for n keys where key k has weight 1 / (k + 1)^s
+ *
+ * @param n The number of keys
+ * @param s The skew. 0 is uniform; about 1 is typical of cache workloads.
+ * @return A pointer to the generator
+ */
+static inline ZipfGen* create_zipfgen(size_t n, double s) {
+    ZipfGen* zipf = (ZipfGen *) malloc(sizeof(ZipfGen));
+    zipf->cdf = (double *) malloc(n * sizeof(double));
+    zipf->n = n;
+    double sum = 0;
+    for (size_t k = 0; k < n; k++) {
+        sum += 1.0 / pow((double) (k + 1), s);
+        zipf->cdf[k] = sum;
+    }
+    for (size_t k = 0; k < n; k++) zipf->cdf[k] /= sum;
+    return zipf;
+}
+
+/**
+ * zipfNext
+ *
+ * Draw the next key from the distribution
+ *
+ * @param zipf A pointer to the generator
+ * @param state A pointer to the random generator state
+ * @return a key in [0, n)
+ */
+static inline size_t zipfNext(ZipfGen* zipf, uint64_t* state) {
+    double u = (benchRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+    size_t lo = 0, hi = zipf->n - 1;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (zipf->cdf[mid] < u) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * destroyZipfGen
+ *
+ * Free the generator
+ *
+ * @param zipf A pointer to the generator
+ */
+static inline void destroyZipfGen(ZipfGen* zipf) {
+    free(zipf->cdf);
+    free(zipf);
+}
+#endif
@@ -0,0 +1,143 @@
+// A flat-combining front end for a doublely linked list
+
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "combining_list.h"
+
+/** Checks of the slot between attempts to yield the processor */
+#define FC_SPINS 64
+
+// What fcApply returns for an insert that worked. The node itself is not
+// handed out, since another thread's remove may free it at any time.
+#define FC_INSERTED ((void*) 1)
+
+// Apply one operation to the list and return its result
+static void* apply_op(DLinkedList* list, int op, void* data) {
+	switch (op) {
+	case FC_INSERT_HEAD:
+	case FC_INSERT_TAIL: {
+		LLNode* node = create_llnode(data);
+		if (node == NULL) return NULL;
+		if (op == FC_INSERT_HEAD) insertNodeHead(list, node);
+		else insertNodeTail(list, node);
+		return FC_INSERTED;
+	}
+	case FC_REMOVE_HEAD:
+		getHead(list);
+		return removeForward(list);
+	case FC_REMOVE_TAIL:
+		getTail(list);
+		return removeBackward(list);
+	case FC_GET_HEAD:
+		return list->head != NULL ? list->head->data : NULL;
+	case FC_GET_SIZE:
+		return (void*) (intptr_t) getSize(list);
+	}
+	return NULL;
+}
+
+// Make one pass over the slots, applying every pending operation in order.
+// Only called with the combiner flag held.
+static void combine(CombiningList* cl) {
+	int limit = __atomic_load_n(&cl->slotLimit, __ATOMIC_ACQUIRE);
+	size_t applied = 0;
+	for (int i = 0; i < limit; i++) {
+		FCSlot* slot = &cl->slots[i];
+		int op = __atomic_load_n(&slot->op, __ATOMIC_ACQUIRE);
+		if (op == FC_NONE) continue;
+		slot->data = apply_op(cl->list, op, slot->data);
+		__atomic_store_n(&slot->op, FC_NONE, __ATOMIC_RELEASE);
+		applied++;
+	}
+	cl->passes++;
+	cl->combined += applied;
+}
+
+CombiningList* create_combininglist(void) {
+	// Create space for the list, aligned so each slot has its own line
+	CombiningList* cl = (CombiningList *) aligned_alloc(FC_CACHE_LINE, sizeof(CombiningList));
+	if (cl == NULL) return NULL;
+	memset(cl, 0, sizeof(CombiningList));
+	cl->list = create_dlinkedlist();
+	if (cl->list == NULL) {
+		free(cl);
+		return NULL;
+	}
+	for (int i = 0; i < FC_MAX_THREADS; i++)
+		cl->slots[i].owner = cl;
+	return cl;
+}
+
+void destroyCombiningList(CombiningList* cl) {
+	destroyList(cl->list);
+	free(cl);
+}
+
+FCSlot* fcRegister(CombiningList* cl) {
+	for (int i = 0; i < FC_MAX_THREADS; i++) {
+		FCSlot* slot = &cl->slots[i];
+		int expected = 0;
+		if (__atomic_load_n(&slot->inUse, __ATOMIC_RELAXED) == 0 &&
+				__atomic_compare_exchange_n(&slot->inUse, &expected, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+			// Widen the combiner's pass to cover this slot
+			int limit = __atomic_load_n(&cl->slotLimit, __ATOMIC_RELAXED);
+			while (limit < i + 1 &&
+					!__atomic_compare_exchange_n(&cl->slotLimit, &limit, i + 1, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+			return slot;
+		}
+	}
+	return NULL;
+}
+
+void fcUnregister(FCSlot* slot) {
+	__atomic_store_n(&slot->inUse, 0, __ATOMIC_RELEASE);
+}
+
+void* fcApply(FCSlot* slot, int op, void* data) {
+	CombiningList* cl = slot->owner;
+
+	// Publish the request; the release store hands data over with it
+	slot->data = data;
+	__atomic_store_n(&slot->op, op, __ATOMIC_RELEASE);
+
+	while (1) {
+		// Become the combiner if nobody else is
+		if (!__atomic_load_n(&cl->combining, __ATOMIC_RELAXED) &&
+				!__atomic_exchange_n(&cl->combining, 1, __ATOMIC_ACQUIRE)) {
+			combine(cl);
+			__atomic_store_n(&cl->combining, 0, __ATOMIC_RELEASE);
+		}
+
+		// Otherwise wait for the combiner to get to this slot
+		for (int spin = 0; spin < FC_SPINS; spin++)
+			if (__atomic_load_n(&slot->op, __ATOMIC_ACQUIRE) == FC_NONE)
+				return slot->data;
+		sched_yield();
+	}
+}
+
+int fcInsertHead(FCSlot* slot, void* data) {
+	return fcApply(slot, FC_INSERT_HEAD, data) != NULL;
+}
+
+int fcInsertTail(FCSlot* slot, void* data) {
+	return fcApply(slot, FC_INSERT_TAIL, data) != NULL;
+}
+
+void* fcRemoveHead(FCSlot* slot) {
+	return fcApply(slot, FC_REMOVE_HEAD, NULL);
+}
+
+void* fcRemoveTail(FCSlot* slot) {
+	return fcApply(slot, FC_REMOVE_TAIL, NULL);
+}
+
+void* fcGetHead(FCSlot* slot) {
+	return fcApply(slot, FC_GET_HEAD, NULL);
+}
+
+int fcGetSize(FCSlot* slot) {
+	return (int) (intptr_t) fcApply(slot, FC_GET_SIZE, NULL);
+}
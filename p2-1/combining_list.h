@@ -0,0 +1,190 @@
+/** @file combining_list.h */
+#ifndef COMBININGLIST_H
+#define COMBININGLIST_H
+
+#include <stddef.h>
+#include "doublely_linked_list.h"
+
+/** The most threads that can be registered with one list at once */
+#define FC_MAX_THREADS 64
+
+/** The cache line size publication slots are aligned to */
+#define FC_CACHE_LINE 64
+
+/** The operations a thread can publish */
+#define FC_NONE 0
+#define FC_INSERT_HEAD 1
+#define FC_INSERT_TAIL 2
+#define FC_REMOVE_HEAD 3
+#define FC_REMOVE_TAIL 4
+#define FC_GET_HEAD 5
+#define FC_GET_SIZE 6
+
+
+/********************************************
+ * Combining list library functions         *
+ * A flat-combining front end for a         *
+ * doublely linked list. Threads publish    *
+ * operations in their own slot; whichever  *
+ * thread takes the combiner flag applies   *
+ * every pending operation in one pass.     *
+ ********************************************/
+
+
+/**
+ * This structure represents one registered thread's publication slot.
+ */
+typedef struct fcslot_t {
+    /** The pending operation, or FC_NONE once the combiner has applied it */
+    int op;
+
+    /** 1 while this slot is registered to a thread */
+    int inUse;
+
+    /** The operation's data going in, and its result coming out */
+    void* data;
+
+    /** The list this slot belongs to */
+    struct combininglist_t* owner;
+} __attribute__((aligned(FC_CACHE_LINE))) FCSlot;
+
+/**
+ * This structure represents a list behind a flat combiner.
+ */
+typedef struct combininglist_t {
+    /** The underlying list. Only the combiner touches it. */
+    DLinkedList* list;
+
+    /** 1 while some thread is combining */
+    int combining;
+
+    /** One past the highest slot ever registered, so passes stop early */
+    int slotLimit;
+
+    /** The number of combining passes made */
+    size_t passes;
+
+    /** The number of operations applied by those passes */
+    size_t combined;
+
+    /** The publication slots */
+    FCSlot slots[FC_MAX_THREADS];
+} CombiningList;
+
+
+/**
+ * create_combininglist
+ *
+ * Creates an empty combining list by allocating memory for it on the heap.
+ *
+ * @return A pointer to an empty list, or NULL if allocation failed
+ */
+CombiningList* create_combininglist(void);
+
+/**
+ * destroyCombiningList
+ *
+ * Destroy the list. As with destroyList, nodes and data are all freed. Every
+ * thread must have unregistered first.
+ *
+ * @param cl A pointer to the list
+ */
+void destroyCombiningList(CombiningList* cl);
+
+/**
+ * fcRegister
+ *
+ * Claim a publication slot for the calling thread.
+ *
+ * @param cl A pointer to the list
+ * @return the thread's slot, or NULL if FC_MAX_THREADS are already registered
+ */
+FCSlot* fcRegister(CombiningList* cl);
+
+/**
+ * fcUnregister
+ *
+ * Release the calling thread's slot.
+ *
+ * @param slot The thread's slot
+ */
+void fcUnregister(FCSlot* slot);
+
+/**
+ * fcApply
+ *
+ * Publish an operation and wait for it to be applied, combining the pending
+ * operations of other threads if the combiner flag is free.
+ *
+ * @param slot The calling thread's slot
+ * @param op One of the FC_ operations
+ * @param data The data to insert, or NULL for the other operations
+ * @return the removed or head data for FC_REMOVE_HEAD, FC_REMOVE_TAIL and
+ *         FC_GET_HEAD, the size for FC_GET_SIZE, or a non-NULL value for
+ *         an insert that worked. An insert that could not allocate a node
+ *         returns NULL.
+ */
+void* fcApply(FCSlot* slot, int op, void* data);
+
+/**
+ * fcInsertHead
+ *
+ * Insert the data at the head of the list.
+ *
+ * @param slot The calling thread's slot
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted, 0 if no node could be allocated
+ */
+int fcInsertHead(FCSlot* slot, void* data);
+
+/**
+ * fcInsertTail
+ *
+ * Insert the data at the tail of the list.
+ *
+ * @param slot The calling thread's slot
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted, 0 if no node could be allocated
+ */
+int fcInsertTail(FCSlot* slot, void* data);
+
+/**
+ * fcRemoveHead
+ *
+ * Remove the head of the list.
+ *
+ * @param slot The calling thread's slot
+ * @return the data of the removed node, or NULL if the list is empty
+ */
+void* fcRemoveHead(FCSlot* slot);
+
+/**
+ * fcRemoveTail
+ *
+ * Remove the tail of the list.
+ *
+ * @param slot The calling thread's slot
+ * @return the data of the removed node, or NULL if the list is empty
+ */
+void* fcRemoveTail(FCSlot* slot);
+
+/**
+ * fcGetHead
+ *
+ * Return the data at the head of the list without removing it.
+ *
+ * @param slot The calling thread's slot
+ * @return the head's data, or NULL if the list is empty
+ */
+void* fcGetHead(FCSlot* slot);
+
+/**
+ * fcGetSize
+ *
+ * Return the size of the list.
+ *
+ * @param slot The calling thread's slot
+ * @return the size
+ */
+int fcGetSize(FCSlot* slot);
+#endif
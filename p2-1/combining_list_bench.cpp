@@ -0,0 +1,102 @@
+// The flat-combining list against one mutex around a DLinkedList and the
+// lock-free MPSC queue, from 1 to 32 threads
+//
+// Usage: ./combining_list_bench [operations per thread]
+//
+// "append" has every thread call insertTail; the MPSC queue's producers do
+// the same with one atomic exchange each. "pairs" has every thread alternate
+// insertTail and removing the head, which the MPSC queue cannot do from many
+// threads. The combining rows also report the mean batch per pass.
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "combining_list.h"
+#include "mpsc_queue.h"
+
+struct Workload {
+	CombiningList* cl;
+	DLinkedList* list;
+	MPSCQueue* queue;
+	pthread_mutex_t mutex;
+	long ops;
+	int pairs;
+};
+
+static void* combining_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	FCSlot* slot = fcRegister(w->cl);
+	for (long i = 0; i < w->ops; i++) {
+		fcInsertTail(slot, w);
+		if (w->pairs) fcRemoveHead(slot);
+	}
+	fcUnregister(slot);
+	return NULL;
+}
+
+static void* mutex_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	for (long i = 0; i < w->ops; i++) {
+		pthread_mutex_lock(&w->mutex);
+		insertTail(w->list, w);
+		pthread_mutex_unlock(&w->mutex);
+		if (!w->pairs) continue;
+		pthread_mutex_lock(&w->mutex);
+		getHead(w->list);
+		removeForward(w->list);
+		pthread_mutex_unlock(&w->mutex);
+	}
+	return NULL;
+}
+
+static void* lockfree_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	MPSCProducer* producer = create_mpscproducer(w->queue);
+	for (long i = 0; i < w->ops; i++)
+		mpscInsertTail(producer, w);
+	destroyMPSCProducer(producer);
+	return NULL;
+}
+
+int main(int argc, char** argv)
+{
+	Workload w;
+	w.ops = argc > 1 ? atol(argv[1]) : 200000;
+	pthread_mutex_init(&w.mutex, NULL);
+
+	for (w.pairs = 0; w.pairs <= 1; w.pairs++) {
+		const char* workload = w.pairs ? "pairs " : "append";
+		for (int threads = 1; threads <= 32; threads *= 2) {
+			char name[64];
+			double ops = (double) w.ops * threads * (1 + w.pairs);
+
+			w.list = create_dlinkedlist();
+			double seconds = benchRunThreads(threads, mutex_body, &w);
+			snprintf(name, sizeof(name), "%s mutex     threads=%2d", workload, threads);
+			benchReport(name, ops, seconds);
+			benchDrain(w.list);
+			destroyList(w.list);
+
+			w.cl = create_combininglist();
+			seconds = benchRunThreads(threads, combining_body, &w);
+			snprintf(name, sizeof(name), "%s combining threads=%2d batch=%.1f", workload, threads,
+					(double) w.cl->combined / w.cl->passes);
+			benchReport(name, ops, seconds);
+			benchDrain(w.cl->list);
+			destroyCombiningList(w.cl);
+
+			if (w.pairs) continue;
+			w.queue = create_mpscqueue();
+			seconds = benchRunThreads(threads, lockfree_body, &w);
+			snprintf(name, sizeof(name), "%s lock-free threads=%2d", workload, threads);
+			benchReport(name, ops, seconds);
+			destroyMPSCQueue(w.queue);
+		}
+	}
+
+	pthread_mutex_destroy(&w.mutex);
+	return 0;
+}
@@ -0,0 +1,112 @@
+#include <pthread.h>
+#include <stdint.h>
+#include "combining_list.h"
+#include "gtest/gtest.h"
+
+
+#define WORKERS 4
+#define ITEMS_PER_WORKER 20000
+
+struct WorkerArgs {
+	CombiningList* cl;
+	uintptr_t id;
+	char* seen;
+	int removed;
+};
+
+// Appends its own items and removes whatever is at the head, alternately
+static void* worker_thread(void* arg)
+{
+	WorkerArgs* args = (WorkerArgs*) arg;
+	FCSlot* slot = fcRegister(args->cl);
+	for (uintptr_t i = 0; i < ITEMS_PER_WORKER; i++) {
+		fcInsertTail(slot, (void*) (1 + args->id * ITEMS_PER_WORKER + i));
+		uintptr_t value = (uintptr_t) fcRemoveHead(slot);
+		if (value != 0) {
+			args->seen[value - 1]++;
+			args->removed++;
+		}
+	}
+	fcUnregister(slot);
+	return NULL;
+}
+
+
+TEST(CombiningList, SingleThread)
+{
+	CombiningList* cl = create_combininglist();
+	ASSERT_TRUE(cl != NULL);
+	FCSlot* slot = fcRegister(cl);
+	ASSERT_TRUE(slot != NULL);
+
+	EXPECT_EQ(NULL, fcRemoveHead(slot));
+	EXPECT_EQ(NULL, fcGetHead(slot));
+	EXPECT_EQ(1, fcInsertTail(slot, (void*) 2));
+	EXPECT_EQ(1, fcInsertHead(slot, (void*) 1));
+	EXPECT_EQ(1, fcInsertTail(slot, (void*) 3));
+	EXPECT_EQ(3, fcGetSize(slot));
+	EXPECT_EQ((void*) 1, fcGetHead(slot));
+	EXPECT_EQ((void*) 3, fcRemoveTail(slot));
+	EXPECT_EQ((void*) 1, fcRemoveHead(slot));
+	EXPECT_EQ((void*) 2, fcRemoveHead(slot));
+	EXPECT_EQ(0, fcGetSize(slot));
+
+	// NULL data still reports a successful insert
+	EXPECT_EQ(1, fcInsertHead(slot, NULL));
+	EXPECT_EQ(1, fcGetSize(slot));
+	EXPECT_EQ(NULL, fcRemoveHead(slot));
+
+	// Every operation went through the combiner
+	EXPECT_EQ(14u, cl->combined);
+
+	fcUnregister(slot);
+	destroyCombiningList(cl);
+}
+
+TEST(CombiningList, RegisterReusesSlots)
+{
+	CombiningList* cl = create_combininglist();
+	FCSlot* slots[FC_MAX_THREADS];
+	for (int i = 0; i < FC_MAX_THREADS; i++)
+		ASSERT_TRUE((slots[i] = fcRegister(cl)) != NULL);
+	EXPECT_EQ(NULL, fcRegister(cl));
+	fcUnregister(slots[5]);
+	EXPECT_EQ(slots[5], fcRegister(cl));
+	for (int i = 0; i < FC_MAX_THREADS; i++)
+		fcUnregister(slots[i]);
+	destroyCombiningList(cl);
+}
+
+TEST(CombiningList, ManyThreads)
+{
+	CombiningList* cl = create_combininglist();
+	char* seen = (char*) calloc(WORKERS * ITEMS_PER_WORKER, 1);
+	pthread_t threads[WORKERS];
+	WorkerArgs args[WORKERS];
+	for (int w = 0; w < WORKERS; w++) {
+		args[w].cl = cl;
+		args[w].id = w;
+		args[w].seen = seen;
+		args[w].removed = 0;
+		pthread_create(&threads[w], NULL, worker_thread, &args[w]);
+	}
+
+	int removed = 0;
+	for (int w = 0; w < WORKERS; w++) {
+		pthread_join(threads[w], NULL);
+		removed += args[w].removed;
+	}
+
+	// Drain what is left; every item comes out exactly once
+	FCSlot* slot = fcRegister(cl);
+	EXPECT_EQ(WORKERS * ITEMS_PER_WORKER - removed, fcGetSize(slot));
+	for (uintptr_t value; (value = (uintptr_t) fcRemoveHead(slot)) != 0; )
+		seen[value - 1]++;
+	for (int i = 0; i < WORKERS * ITEMS_PER_WORKER; i++)
+		ASSERT_EQ(1, seen[i]);
+	EXPECT_LT(0u, cl->passes);
+
+	fcUnregister(slot);
+	free(seen);
+	destroyCombiningList(cl);
+}
@@ -0,0 +1,140 @@
+// A reader-writer locked doublely-linked list with per-thread cursors
+
+#include <stdlib.h>
+#include "concurrent_list.h"
+
+// Run a list operation at the cursor's position. Only called in write
+// sessions, where nobody else can see the list's current pointer.
+static void enter_cursor(ListCursor* cursor) {
+	cursor->owner->list->current = cursor->node;
+}
+
+static void leave_cursor(ListCursor* cursor) {
+	cursor->node = cursor->owner->list->current;
+	cursor->owner->list->current = NULL;
+}
+
+ConcurrentList* create_concurrentlist(void) {
+	// Create space for the wrapper and its list
+	ConcurrentList* cl = (ConcurrentList *) malloc(sizeof(ConcurrentList));
+	if (cl == NULL) return NULL;
+	cl->list = create_dlinkedlist();
+	if (cl->list == NULL) {
+		free(cl);
+		return NULL;
+	}
+
+	// Initialize the lock
+	pthread_rwlock_init(&cl->lock, NULL);
+	return cl;
+}
+
+void destroyConcurrentList(ConcurrentList* cl) {
+	destroyList(cl->list);
+	pthread_rwlock_destroy(&cl->lock);
+	free(cl);
+}
+
+void concurrentInsertHead(ConcurrentList* cl, void* data) {
+	pthread_rwlock_wrlock(&cl->lock);
+	insertHead(cl->list, data);
+	pthread_rwlock_unlock(&cl->lock);
+}
+
+void concurrentInsertTail(ConcurrentList* cl, void* data) {
+	pthread_rwlock_wrlock(&cl->lock);
+	insertTail(cl->list, data);
+	pthread_rwlock_unlock(&cl->lock);
+}
+
+int concurrentGetSize(ConcurrentList* cl) {
+	pthread_rwlock_rdlock(&cl->lock);
+	int size = getSize(cl->list);
+	pthread_rwlock_unlock(&cl->lock);
+	return size;
+}
+
+void beginRead(ConcurrentList* cl, ListCursor* cursor) {
+	pthread_rwlock_rdlock(&cl->lock);
+	cursor->owner = cl;
+	cursor->node = NULL;
+	cursor->writing = 0;
+}
+
+void beginWrite(ConcurrentList* cl, ListCursor* cursor) {
+	pthread_rwlock_wrlock(&cl->lock);
+	cursor->owner = cl;
+	cursor->node = NULL;
+	cursor->writing = 1;
+}
+
+void endAccess(ListCursor* cursor) {
+	cursor->node = NULL;
+	pthread_rwlock_unlock(&cursor->owner->lock);
+}
+
+void* cursorHead(ListCursor* cursor) {
+	cursor->node = cursor->owner->list->head;
+	return cursorGet(cursor);
+}
+
+void* cursorTail(ListCursor* cursor) {
+	cursor->node = cursor->owner->list->tail;
+	return cursorGet(cursor);
+}
+
+void* cursorGet(ListCursor* cursor) {
+	// Only return data if the cursor is on the list
+	if (cursor->node != NULL) return cursor->node->data;
+
+	// Return NULL otherwise
+	return NULL;
+}
+
+void* cursorNext(ListCursor* cursor) {
+	// Only move if the cursor is on the list
+	if (cursor->node != NULL) cursor->node = cursor->node->next;
+	return cursorGet(cursor);
+}
+
+void* cursorPrevious(ListCursor* cursor) {
+	// Only move if the cursor is on the list
+	if (cursor->node != NULL) cursor->node = cursor->node->previous;
+	return cursorGet(cursor);
+}
+
+int cursorInsertAfter(ListCursor* cursor, void* data) {
+	// Readers may not modify the list
+	if (!cursor->writing) return 0;
+	enter_cursor(cursor);
+	int inserted = insertAfter(cursor->owner->list, data);
+	leave_cursor(cursor);
+	return inserted;
+}
+
+int cursorInsertBefore(ListCursor* cursor, void* data) {
+	// Readers may not modify the list
+	if (!cursor->writing) return 0;
+	enter_cursor(cursor);
+	int inserted = insertBefore(cursor->owner->list, data);
+	leave_cursor(cursor);
+	return inserted;
+}
+
+void* cursorRemoveForward(ListCursor* cursor) {
+	// Readers may not modify the list
+	if (!cursor->writing) return NULL;
+	enter_cursor(cursor);
+	void* data = removeForward(cursor->owner->list);
+	leave_cursor(cursor);
+	return data;
+}
+
+void* cursorRemoveBackward(ListCursor* cursor) {
+	// Readers may not modify the list
+	if (!cursor->writing) return NULL;
+	enter_cursor(cursor);
+	void* data = removeBackward(cursor->owner->list);
+	leave_cursor(cursor);
+	return data;
+}
@@ -0,0 +1,221 @@
+/** @file concurrent_list.h */
+#ifndef CONCURRENTLIST_H
+#define CONCURRENTLIST_H
+
+#include <pthread.h>
+#include "doublely_linked_list.h"
+
+
+/********************************************
+ * Concurrent list library functions        *
+ * A doublely linked list guarded by a      *
+ * reader-writer lock. Each thread walks    *
+ * the list with its own cursor instead of  *
+ * the list's shared current pointer.       *
+ ********************************************/
+
+
+/**
+ * This structure represents a list shared between threads.
+ */
+typedef struct concurrentlist_t {
+    /** The underlying list. Its current pointer is only used inside write sessions. */
+    DLinkedList* list;
+
+    /** Shared by readers, held exclusively by writers */
+    pthread_rwlock_t lock;
+} ConcurrentList;
+
+/**
+ * This structure represents one thread's position in a concurrent list.
+ * A cursor is only valid between beginRead or beginWrite and endAccess,
+ * and must not be shared between threads.
+ */
+typedef struct listcursor_t {
+    /** The list this cursor walks */
+    ConcurrentList* owner;
+
+    /** The node the cursor points at. NULL if it is off the list. */
+    LLNode* node;
+
+    /** 1 inside a write session, 0 inside a read session */
+    int writing;
+} ListCursor;
+
+
+/**
+ * create_concurrentlist
+ *
+ * Creates an empty concurrent list by allocating memory for it on the heap.
+ *
+ * @return A pointer to an empty concurrent list, or NULL if allocation failed
+ */
+ConcurrentList* create_concurrentlist(void);
+
+/**
+ * destroyConcurrentList
+ *
+ * Destroy the concurrent list. As with destroyList, nodes and data are all
+ * freed. No other thread may be using the list.
+ *
+ * @param cl A pointer to the concurrent list
+ */
+void destroyConcurrentList(ConcurrentList* cl);
+
+/**
+ * concurrentInsertHead
+ *
+ * Insert the data at the head of the list under the write lock.
+ *
+ * @param cl A pointer to the concurrent list
+ * @param data A void pointer to the data to insert
+ */
+void concurrentInsertHead(ConcurrentList* cl, void* data);
+
+/**
+ * concurrentInsertTail
+ *
+ * Insert the data at the tail of the list under the write lock.
+ *
+ * @param cl A pointer to the concurrent list
+ * @param data A void pointer to the data to insert
+ */
+void concurrentInsertTail(ConcurrentList* cl, void* data);
+
+/**
+ * concurrentGetSize
+ *
+ * Return the size of the list under the read lock.
+ *
+ * @param cl A pointer to the concurrent list
+ * @return the size
+ */
+int concurrentGetSize(ConcurrentList* cl);
+
+/**
+ * beginRead
+ *
+ * Take the read lock and start a read session. Any number of threads may read
+ * at once. The cursor starts off the list; move it with cursorHead or cursorTail.
+ *
+ * @param cl A pointer to the concurrent list
+ * @param cursor A pointer to the calling thread's cursor
+ */
+void beginRead(ConcurrentList* cl, ListCursor* cursor);
+
+/**
+ * beginWrite
+ *
+ * Take the write lock and start a write session, in which the cursor may also
+ * insert and remove. The cursor starts off the list.
+ *
+ * @param cl A pointer to the concurrent list
+ * @param cursor A pointer to the calling thread's cursor
+ */
+void beginWrite(ConcurrentList* cl, ListCursor* cursor);
+
+/**
+ * endAccess
+ *
+ * End the cursor's session and release its lock.
+ *
+ * @param cursor A pointer to the cursor
+ */
+void endAccess(ListCursor* cursor);
+
+/**
+ * cursorHead
+ *
+ * Move the cursor to the head of the list
+ *
+ * @param cursor A pointer to the cursor
+ * @return the head data or NULL if the list is empty
+ */
+void* cursorHead(ListCursor* cursor);
+
+/**
+ * cursorTail
+ *
+ * Move the cursor to the tail of the list
+ *
+ * @param cursor A pointer to the cursor
+ * @return the tail data or NULL if the list is empty
+ */
+void* cursorTail(ListCursor* cursor);
+
+/**
+ * cursorGet
+ *
+ * Return the data the cursor points at
+ *
+ * @param cursor A pointer to the cursor
+ * @return the data or NULL if the cursor is off the list
+ */
+void* cursorGet(ListCursor* cursor);
+
+/**
+ * cursorNext
+ *
+ * Move the cursor to the next node, as getNext does
+ *
+ * @param cursor A pointer to the cursor
+ * @return the next data or NULL if there is none
+ */
+void* cursorNext(ListCursor* cursor);
+
+/**
+ * cursorPrevious
+ *
+ * Move the cursor to the previous node, as getPrevious does
+ *
+ * @param cursor A pointer to the cursor
+ * @return the previous data or NULL if there is none
+ */
+void* cursorPrevious(ListCursor* cursor);
+
+/**
+ * cursorInsertAfter
+ *
+ * Insert data after the cursor, as insertAfter does. Write sessions only.
+ *
+ * @param cursor A pointer to the cursor
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted
+ *         0 if the cursor is off the list or in a read session
+ */
+int cursorInsertAfter(ListCursor* cursor, void* data);
+
+/**
+ * cursorInsertBefore
+ *
+ * Insert data before the cursor, as insertBefore does. Write sessions only.
+ *
+ * @param cursor A pointer to the cursor
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted
+ *         0 if the cursor is off the list or in a read session
+ */
+int cursorInsertBefore(ListCursor* cursor, void* data);
+
+/**
+ * cursorRemoveForward
+ *
+ * Remove the node under the cursor and move forward, as removeForward does.
+ * Write sessions only.
+ *
+ * @param cursor A pointer to the cursor
+ * @return the removed data, or NULL if the cursor is off the list or in a read session
+ */
+void* cursorRemoveForward(ListCursor* cursor);
+
+/**
+ * cursorRemoveBackward
+ *
+ * Remove the node under the cursor and move backward, as removeBackward does.
+ * Write sessions only.
+ *
+ * @param cursor A pointer to the cursor
+ * @return the removed data, or NULL if the cursor is off the list or in a read session
+ */
+void* cursorRemoveBackward(ListCursor* cursor);
+#endif
@@ -0,0 +1,110 @@
+// Contention on the reader-writer locked list against one mutex around a
+// DLinkedList, from 1 to 32 threads
+//
+// Usage: ./concurrent_list_bench [operations per thread] [percent writes]
+//
+// A read walks the first WALK nodes and reads the size. A write appends one
+// node and removes the head, so the list length stays constant.
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "concurrent_list.h"
+
+#define PREFILL 1000
+#define WALK 32
+
+struct Workload {
+	ConcurrentList* cl;
+	DLinkedList* list;
+	pthread_mutex_t mutex;
+	long ops;
+	int writePercent;
+	int sink;
+};
+
+static void* rwlock_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	uint64_t rng = 0x9e3779b97f4a7c15ULL * (t->index + 1);
+	int sink = 0;
+	for (long i = 0; i < w->ops; i++) {
+		ListCursor cursor;
+		if ((int) (benchRandom(&rng) % 100) < w->writePercent) {
+			beginWrite(w->cl, &cursor);
+			cursorTail(&cursor);
+			cursorInsertAfter(&cursor, w);
+			cursorHead(&cursor);
+			cursorRemoveForward(&cursor);
+			endAccess(&cursor);
+			continue;
+		}
+		beginRead(w->cl, &cursor);
+		void* d = cursorHead(&cursor);
+		for (int n = 0; n < WALK && d != NULL; n++)
+			d = cursorNext(&cursor);
+		sink += getSize(w->cl->list) + (d != NULL);
+		endAccess(&cursor);
+	}
+	__atomic_fetch_add(&w->sink, sink, __ATOMIC_RELAXED);
+	return NULL;
+}
+
+static void* mutex_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	uint64_t rng = 0x9e3779b97f4a7c15ULL * (t->index + 1);
+	int sink = 0;
+	for (long i = 0; i < w->ops; i++) {
+		pthread_mutex_lock(&w->mutex);
+		if ((int) (benchRandom(&rng) % 100) < w->writePercent) {
+			insertTail(w->list, w);
+			getHead(w->list);
+			removeForward(w->list);
+		} else {
+			// Readers share the list's cursor, so they need the mutex too
+			LLNode* node = w->list->head;
+			for (int n = 0; n < WALK && node != NULL; n++)
+				node = node->next;
+			sink += getSize(w->list) + (node != NULL);
+		}
+		pthread_mutex_unlock(&w->mutex);
+	}
+	__atomic_fetch_add(&w->sink, sink, __ATOMIC_RELAXED);
+	return NULL;
+}
+
+int main(int argc, char** argv)
+{
+	Workload w;
+	w.ops = argc > 1 ? atol(argv[1]) : 100000;
+	w.writePercent = argc > 2 ? atoi(argv[2]) : 10;
+	w.sink = 0;
+	pthread_mutex_init(&w.mutex, NULL);
+
+	for (int threads = 1; threads <= 32; threads *= 2) {
+		char name[64];
+		w.cl = create_concurrentlist();
+		w.list = create_dlinkedlist();
+		for (int i = 0; i < PREFILL; i++) {
+			concurrentInsertTail(w.cl, &w);
+			insertTail(w.list, &w);
+		}
+
+		double seconds = benchRunThreads(threads, rwlock_body, &w);
+		snprintf(name, sizeof(name), "rwlock  threads=%2d writes=%d%%", threads, w.writePercent);
+		benchReport(name, (double) w.ops * threads, seconds);
+
+		seconds = benchRunThreads(threads, mutex_body, &w);
+		snprintf(name, sizeof(name), "mutex   threads=%2d writes=%d%%", threads, w.writePercent);
+		benchReport(name, (double) w.ops * threads, seconds);
+
+		benchDrain(w.cl->list);
+		benchDrain(w.list);
+		destroyConcurrentList(w.cl);
+		destroyList(w.list);
+	}
+
+	pthread_mutex_destroy(&w.mutex);
+	return w.sink == -1;
+}
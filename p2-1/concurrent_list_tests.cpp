@@ -0,0 +1,94 @@
+#include <pthread.h>
+#include "concurrent_list.h"
+#include "gtest/gtest.h"
+
+
+struct ListItem {};
+
+#define WRITERS 4
+#define READERS 4
+#define ITEMS_PER_WRITER 2000
+
+// Appends its share of items to the shared list
+static void* writer_thread(void* arg)
+{
+	ConcurrentList* cl = (ConcurrentList*) arg;
+	for (int i = 0; i < ITEMS_PER_WRITER; i++)
+		concurrentInsertTail(cl, malloc(sizeof(ListItem)));
+	return NULL;
+}
+
+// Walks the list with its own cursor, checking the size matches the walk
+static void* reader_thread(void* arg)
+{
+	ConcurrentList* cl = (ConcurrentList*) arg;
+	long mismatches = 0;
+	for (int pass = 0; pass < 50; pass++) {
+		ListCursor cursor;
+		beginRead(cl, &cursor);
+		int count = 0;
+		for (void* d = cursorHead(&cursor); d != NULL; d = cursorNext(&cursor))
+			count++;
+		if (count != getSize(cl->list)) mismatches++;
+		endAccess(&cursor);
+	}
+	return (void*) mismatches;
+}
+
+
+TEST(ConcurrentList, CursorReadWrite)
+{
+	int a, b, c;
+	ConcurrentList* cl = create_concurrentlist();
+	concurrentInsertTail(cl, &a);
+	concurrentInsertTail(cl, &c);
+
+	// Readers can walk but not modify
+	ListCursor cursor;
+	beginRead(cl, &cursor);
+	EXPECT_EQ(&a, cursorHead(&cursor));
+	EXPECT_EQ(0, cursorInsertAfter(&cursor, &b));
+	EXPECT_EQ(NULL, cursorRemoveForward(&cursor));
+	endAccess(&cursor);
+
+	// Writers edit at their own cursor, leaving the list's current pointer alone
+	beginWrite(cl, &cursor);
+	EXPECT_EQ(&a, cursorHead(&cursor));
+	EXPECT_EQ(1, cursorInsertAfter(&cursor, &b));
+	EXPECT_EQ(&a, cursorGet(&cursor));
+	EXPECT_EQ(&b, cursorNext(&cursor));
+	EXPECT_EQ(&b, cursorRemoveForward(&cursor));
+	EXPECT_EQ(&c, cursorGet(&cursor));
+	EXPECT_EQ(&c, cursorRemoveBackward(&cursor));
+	EXPECT_EQ(&a, cursorGet(&cursor));
+	EXPECT_EQ(NULL, cl->list->current);
+	endAccess(&cursor);
+	EXPECT_EQ(1, concurrentGetSize(cl));
+
+	// Empty the list of borrowed pointers before destroying it
+	beginWrite(cl, &cursor);
+	cursorHead(&cursor);
+	cursorRemoveForward(&cursor);
+	endAccess(&cursor);
+	destroyConcurrentList(cl);
+}
+
+TEST(ConcurrentList, ParallelReadersAndWriters)
+{
+	ConcurrentList* cl = create_concurrentlist();
+	pthread_t threads[WRITERS + READERS];
+	for (int i = 0; i < WRITERS; i++)
+		pthread_create(&threads[i], NULL, writer_thread, cl);
+	for (int i = 0; i < READERS; i++)
+		pthread_create(&threads[WRITERS + i], NULL, reader_thread, cl);
+
+	// Readers must always see a consistent list
+	for (int i = 0; i < WRITERS + READERS; i++) {
+		void* mismatches;
+		pthread_join(threads[i], &mismatches);
+		EXPECT_EQ(NULL, mismatches);
+	}
+	EXPECT_EQ(WRITERS * ITEMS_PER_WRITER, concurrentGetSize(cl));
+
+	destroyConcurrentList(cl);
+}
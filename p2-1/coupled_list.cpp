@@ -0,0 +1,159 @@
+// A doublely linked list with per-node locks and hand-over-hand cursors
+
+#include <stdlib.h>
+#include "coupled_list.h"
+
+// Allocate a node with its own lock
+static LockedNode* create_lockednode(void* data) {
+	LockedNode* node = (LockedNode *) malloc(sizeof(LockedNode));
+	if (node == NULL) return NULL;
+	node->node.data = data;
+	node->node.previous = NULL;
+	node->node.next = NULL;
+	pthread_mutex_init(&node->lock, NULL);
+	return node;
+}
+
+// Link a node between two neighbors whose locks the caller holds
+static void link_node(CoupledList* list, LockedNode* previous, LockedNode* next, LockedNode* node) {
+	node->node.previous = &previous->node;
+	node->node.next = &next->node;
+	previous->node.next = &node->node;
+	next->node.previous = &node->node;
+	__atomic_fetch_add(&list->size, 1, __ATOMIC_RELAXED);
+}
+
+CoupledList* create_coupledlist(void) {
+	// Create space for the list
+	CoupledList* list = (CoupledList *) malloc(sizeof(CoupledList));
+	if (list == NULL) return NULL;
+
+	// Point the sentinels at each other
+	list->head.node.data = NULL;
+	list->head.node.previous = NULL;
+	list->head.node.next = &list->tail.node;
+	list->tail.node.data = NULL;
+	list->tail.node.previous = &list->head.node;
+	list->tail.node.next = NULL;
+	pthread_mutex_init(&list->head.lock, NULL);
+	pthread_mutex_init(&list->tail.lock, NULL);
+	list->size = 0;
+	return list;
+}
+
+void destroyCoupledList(CoupledList* list) {
+	// Free every node and its data between the sentinels
+	LLNode* node = list->head.node.next;
+	while (node != &list->tail.node) {
+		LLNode* next = node->next;
+		pthread_mutex_destroy(&((LockedNode*) node)->lock);
+		free(node->data);
+		free(node);
+		node = next;
+	}
+
+	// Free up the list's memory
+	pthread_mutex_destroy(&list->head.lock);
+	pthread_mutex_destroy(&list->tail.lock);
+	free(list);
+}
+
+int coupledInsertHead(CoupledList* list, void* data) {
+	LockedNode* node = create_lockednode(data);
+	if (node == NULL) return 0;
+
+	// Lock the head sentinel, then the node after it
+	pthread_mutex_lock(&list->head.lock);
+	LockedNode* first = (LockedNode*) list->head.node.next;
+	pthread_mutex_lock(&first->lock);
+	link_node(list, &list->head, first, node);
+	pthread_mutex_unlock(&first->lock);
+	pthread_mutex_unlock(&list->head.lock);
+	return 1;
+}
+
+int coupledGetSize(CoupledList* list) {
+	return __atomic_load_n(&list->size, __ATOMIC_RELAXED);
+}
+
+void* coupledBegin(CoupledList* list, CoupledCursor* cursor) {
+	cursor->owner = list;
+	cursor->previous = &list->head;
+	pthread_mutex_lock(&list->head.lock);
+	cursor->current = (LockedNode*) list->head.node.next;
+	pthread_mutex_lock(&cursor->current->lock);
+	return coupledGet(cursor);
+}
+
+void* coupledGet(CoupledCursor* cursor) {
+	if (cursor->current == &cursor->owner->tail) return NULL;
+	return cursor->current->node.data;
+}
+
+void* coupledNext(CoupledCursor* cursor) {
+	// Stay put past the end
+	if (cursor->current == &cursor->owner->tail) return NULL;
+
+	// Take the next lock before letting go of the one behind
+	LockedNode* next = (LockedNode*) cursor->current->node.next;
+	pthread_mutex_lock(&next->lock);
+	pthread_mutex_unlock(&cursor->previous->lock);
+	cursor->previous = cursor->current;
+	cursor->current = next;
+	return coupledGet(cursor);
+}
+
+int coupledInsertAfter(CoupledCursor* cursor, void* data) {
+	// Only insert if the cursor is on a node
+	if (cursor->current == &cursor->owner->tail) return 0;
+	LockedNode* node = create_lockednode(data);
+	if (node == NULL) return 0;
+
+	// The node after the cursor is the only extra lock needed
+	LockedNode* next = (LockedNode*) cursor->current->node.next;
+	pthread_mutex_lock(&next->lock);
+	link_node(cursor->owner, cursor->current, next, node);
+	pthread_mutex_unlock(&next->lock);
+	return 1;
+}
+
+int coupledInsertBefore(CoupledCursor* cursor, void* data) {
+	LockedNode* node = create_lockednode(data);
+	if (node == NULL) return 0;
+
+	// Both neighbors are already held. The new node becomes the one behind
+	// the cursor, so hold its lock in place of the old one. Nobody else can
+	// see it yet, so trying the lock always succeeds and takes no ordering.
+	pthread_mutex_trylock(&node->lock);
+	link_node(cursor->owner, cursor->previous, cursor->current, node);
+	pthread_mutex_unlock(&cursor->previous->lock);
+	cursor->previous = node;
+	return 1;
+}
+
+void* coupledRemoveForward(CoupledCursor* cursor) {
+	// Only remove if the cursor is on a node
+	LockedNode* node = cursor->current;
+	if (node == &cursor->owner->tail) return NULL;
+
+	// Lock the successor, then unlink the node between the held neighbors
+	LockedNode* next = (LockedNode*) node->node.next;
+	pthread_mutex_lock(&next->lock);
+	cursor->previous->node.next = &next->node;
+	next->node.previous = &cursor->previous->node;
+	cursor->current = next;
+	__atomic_fetch_sub(&cursor->owner->size, 1, __ATOMIC_RELAXED);
+
+	// Nobody can be waiting for the node's lock: they would have to hold the
+	// lock of the node before it, which this cursor holds
+	void* data = node->node.data;
+	pthread_mutex_unlock(&node->lock);
+	pthread_mutex_destroy(&node->lock);
+	free(node);
+	return data;
+}
+
+void coupledEnd(CoupledCursor* cursor) {
+	pthread_mutex_unlock(&cursor->current->lock);
+	pthread_mutex_unlock(&cursor->previous->lock);
+}
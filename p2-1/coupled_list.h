@@ -0,0 +1,181 @@
+/** @file coupled_list.h */
+#ifndef COUPLEDLIST_H
+#define COUPLEDLIST_H
+
+#include <pthread.h>
+#include "doublely_linked_list.h"
+
+
+/********************************************
+ * Coupled list library functions           *
+ * A doublely linked list with a lock in    *
+ * every node. Cursors walk forward hand    *
+ * over hand, holding the node they are at  *
+ * and the one before it, so edits at       *
+ * different positions run concurrently.    *
+ ********************************************/
+
+
+/**
+ * This structure represents one node of a coupled list. The LLNode comes
+ * first so a LockedNode can be used wherever its LLNode is expected.
+ */
+typedef struct lockednode_t {
+    /** The links and data. Only change them while holding lock. */
+    LLNode node;
+
+    /** Held by any cursor at or just past this node */
+    pthread_mutex_t lock;
+} LockedNode;
+
+/**
+ * This structure represents an entire coupled list. The head and tail
+ * sentinels are always present, so every real node has neighbors to lock.
+ */
+typedef struct coupledlist_t {
+    /** Sentinel before the first node */
+    LockedNode head;
+
+    /** Sentinel after the last node */
+    LockedNode tail;
+
+    /** The number of real nodes. Updated atomically. */
+    int size;
+} CoupledList;
+
+/**
+ * This structure represents one thread's position in a coupled list. While
+ * the cursor is open it holds the locks of its node and the one before it.
+ * Locks are only ever taken in list order, so cursors cannot deadlock.
+ */
+typedef struct coupledcursor_t {
+    /** The list this cursor walks */
+    CoupledList* owner;
+
+    /** The locked node before the cursor */
+    LockedNode* previous;
+
+    /** The locked node the cursor is at. The tail sentinel past the end. */
+    LockedNode* current;
+} CoupledCursor;
+
+
+/**
+ * create_coupledlist
+ *
+ * Creates an empty coupled list by allocating memory for it on the heap.
+ *
+ * @return A pointer to an empty list, or NULL if allocation failed
+ */
+CoupledList* create_coupledlist(void);
+
+/**
+ * destroyCoupledList
+ *
+ * Destroy the list. As with destroyList, nodes and data are all freed. No
+ * cursor may be open.
+ *
+ * @param list A pointer to the list
+ */
+void destroyCoupledList(CoupledList* list);
+
+/**
+ * coupledInsertHead
+ *
+ * Insert the data at the head of the list, locking only the head sentinel
+ * and the first node.
+ *
+ * @param list A pointer to the list
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted, 0 if no node could be allocated
+ */
+int coupledInsertHead(CoupledList* list, void* data);
+
+/**
+ * coupledGetSize
+ *
+ * Return the size of the list without locking.
+ *
+ * @param list A pointer to the list
+ * @return the size
+ */
+int coupledGetSize(CoupledList* list);
+
+/**
+ * coupledBegin
+ *
+ * Open a cursor at the head of the list.
+ *
+ * @param list A pointer to the list
+ * @param cursor A pointer to the calling thread's cursor
+ * @return the head's data, or NULL if the list is empty
+ */
+void* coupledBegin(CoupledList* list, CoupledCursor* cursor);
+
+/**
+ * coupledGet
+ *
+ * Return the data at the cursor.
+ *
+ * @param cursor A pointer to the open cursor
+ * @return the data, or NULL if the cursor is past the end
+ */
+void* coupledGet(CoupledCursor* cursor);
+
+/**
+ * coupledNext
+ *
+ * Move the cursor forward one node: lock the next node, then release the one
+ * the cursor is leaving behind.
+ *
+ * @param cursor A pointer to the open cursor
+ * @return the next node's data, or NULL if the cursor is now past the end
+ */
+void* coupledNext(CoupledCursor* cursor);
+
+/**
+ * coupledInsertAfter
+ *
+ * Insert a new node after the cursor, as insertAfter does. The cursor does
+ * not move.
+ *
+ * @param cursor A pointer to the open cursor
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted
+ *         0 if the cursor is past the end or no node could be allocated
+ */
+int coupledInsertAfter(CoupledCursor* cursor, void* data);
+
+/**
+ * coupledInsertBefore
+ *
+ * Insert a new node before the cursor, as insertBefore does. Past the end,
+ * this appends to the list. The cursor does not move.
+ *
+ * @param cursor A pointer to the open cursor
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted, 0 if no node could be allocated
+ */
+int coupledInsertBefore(CoupledCursor* cursor, void* data);
+
+/**
+ * coupledRemoveForward
+ *
+ * Remove the node at the cursor and move the cursor forward, as
+ * removeForward does. There is no removeBackward: it would have to lock
+ * against list order.
+ *
+ * @param cursor A pointer to the open cursor
+ * @return the data of the removed node, or NULL if the cursor is past the end
+ */
+void* coupledRemoveForward(CoupledCursor* cursor);
+
+/**
+ * coupledEnd
+ *
+ * Close the cursor and release its locks.
+ *
+ * @param cursor A pointer to the open cursor
+ */
+void coupledEnd(CoupledCursor* cursor);
+#endif
@@ -0,0 +1,139 @@
+// Hand-over-hand locking against one mutex around a DLinkedList, from 1 to
+// 32 threads editing at different positions
+//
+// Usage: ./coupled_list_bench [sessions per thread] [list length] [edits per session] [work per edit]
+//
+// Each thread owns a position spread evenly along the list. A session walks
+// from the head to it and then does a burst of insertAfter/removeForward
+// pairs just past it, leaving the length unchanged, with some work standing
+// in for preparing each edit. Throughput counts edits. The global lock
+// serializes every session; the coupled list only serializes threads passing
+// each other, so it pulls ahead once there are cores to run them and enough
+// work per edit to pay for a lock per step.
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "coupled_list.h"
+
+struct Workload {
+	CoupledList* coupled;
+	DLinkedList* list;
+	pthread_mutex_t mutex;
+	long sessions;
+	long length;
+	int burst;
+	int work;
+};
+
+// Stand-in for the work of preparing one edit
+static uint64_t prepare(Workload* w, uint64_t* rng)
+{
+	uint64_t x = 0;
+	for (int i = 0; i < w->work; i++) x += benchRandom(rng);
+	return x;
+}
+
+// The marker a thread walks to, stored as data at its position
+static uintptr_t marker(BenchThread* t)
+{
+	return 1 + t->index;
+}
+
+static void* coupled_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	void* target = (void*) marker(t);
+	uint64_t rng = 0x9e3779b97f4a7c15ULL * (t->index + 1);
+	for (long s = 0; s < w->sessions; s++) {
+		CoupledCursor cursor;
+		void* d = coupledBegin(w->coupled, &cursor);
+		while (d != target) d = coupledNext(&cursor);
+		for (int e = 0; e < w->burst; e++) {
+			rng += prepare(w, &rng) & 1;
+			coupledInsertAfter(&cursor, w);
+			coupledNext(&cursor);
+			coupledRemoveForward(&cursor);
+		}
+		coupledEnd(&cursor);
+	}
+	return NULL;
+}
+
+static void* global_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	void* target = (void*) marker(t);
+	uint64_t rng = 0x9e3779b97f4a7c15ULL * (t->index + 1);
+	for (long s = 0; s < w->sessions; s++) {
+		pthread_mutex_lock(&w->mutex);
+		void* d = getHead(w->list);
+		while (d != target) d = getNext(w->list);
+		for (int e = 0; e < w->burst; e++) {
+			rng += prepare(w, &rng) & 1;
+			insertAfter(w->list, w);
+			getNext(w->list);
+			removeForward(w->list);
+		}
+		pthread_mutex_unlock(&w->mutex);
+	}
+	return NULL;
+}
+
+// Fill both lists with filler, placing each thread's marker at its position
+static void fill(Workload* w, int threads)
+{
+	CoupledCursor cursor;
+	coupledBegin(w->coupled, &cursor);
+	for (long i = 0; i < w->length; i++) {
+		void* d = w;
+		for (int m = 0; m < threads; m++)
+			if (i == (m + 1) * w->length / (threads + 1)) d = (void*) (uintptr_t) (1 + m);
+		coupledInsertBefore(&cursor, d);
+		insertTail(w->list, d);
+	}
+	coupledEnd(&cursor);
+}
+
+// Remove every node without freeing the borrowed data pointers
+static void drain(Workload* w)
+{
+	CoupledCursor cursor;
+	coupledBegin(w->coupled, &cursor);
+	while (coupledGet(&cursor) != NULL) coupledRemoveForward(&cursor);
+	coupledEnd(&cursor);
+	benchDrain(w->list);
+}
+
+int main(int argc, char** argv)
+{
+	Workload w;
+	w.sessions = argc > 1 ? atol(argv[1]) : 2000;
+	w.length = argc > 2 ? atol(argv[2]) : 1000;
+	w.burst = argc > 3 ? atoi(argv[3]) : 16;
+	w.work = argc > 4 ? atoi(argv[4]) : 100;
+	pthread_mutex_init(&w.mutex, NULL);
+
+	for (int threads = 1; threads <= 32; threads *= 2) {
+		char name[64];
+		double edits = (double) w.sessions * w.burst * threads;
+		w.coupled = create_coupledlist();
+		w.list = create_dlinkedlist();
+		fill(&w, threads);
+
+		double seconds = benchRunThreads(threads, global_body, &w);
+		snprintf(name, sizeof(name), "global lock threads=%2d work=%d", threads, w.work);
+		benchReport(name, edits, seconds);
+
+		seconds = benchRunThreads(threads, coupled_body, &w);
+		snprintf(name, sizeof(name), "coupled     threads=%2d work=%d", threads, w.work);
+		benchReport(name, edits, seconds);
+
+		drain(&w);
+		destroyCoupledList(w.coupled);
+		destroyList(w.list);
+	}
+
+	pthread_mutex_destroy(&w.mutex);
+	return 0;
+}
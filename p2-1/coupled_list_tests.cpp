@@ -0,0 +1,123 @@
+#include <pthread.h>
+#include <stdint.h>
+#include "coupled_list.h"
+#include "gtest/gtest.h"
+
+
+#define WORKERS 4
+#define GAP 50
+#define EDITS 5000
+
+struct WorkerArgs {
+	CoupledList* list;
+	uintptr_t marker;
+};
+
+// Walks to its marker, then repeatedly inserts after it and removes again
+static void* worker_thread(void* arg)
+{
+	WorkerArgs* args = (WorkerArgs*) arg;
+	for (int i = 0; i < EDITS; i++) {
+		CoupledCursor cursor;
+		void* d = coupledBegin(args->list, &cursor);
+		while (d != (void*) args->marker) d = coupledNext(&cursor);
+		coupledInsertAfter(&cursor, (void*) (args->marker + 1));
+		coupledNext(&cursor);
+		coupledRemoveForward(&cursor);
+		coupledEnd(&cursor);
+	}
+	return NULL;
+}
+
+// Remove every node without freeing the borrowed data pointers
+static void drain(CoupledList* list)
+{
+	CoupledCursor cursor;
+	coupledBegin(list, &cursor);
+	while (coupledGet(&cursor) != NULL) coupledRemoveForward(&cursor);
+	coupledEnd(&cursor);
+}
+
+
+TEST(CoupledList, CursorEdits)
+{
+	CoupledList* list = create_coupledlist();
+	ASSERT_TRUE(list != NULL);
+
+	// Empty list: the cursor starts past the end, where insertBefore appends
+	CoupledCursor cursor;
+	EXPECT_EQ(NULL, coupledBegin(list, &cursor));
+	EXPECT_EQ(0, coupledInsertAfter(&cursor, (void*) 1));
+	EXPECT_EQ(NULL, coupledRemoveForward(&cursor));
+	EXPECT_EQ(1, coupledInsertBefore(&cursor, (void*) 4));
+	coupledEnd(&cursor);
+	EXPECT_EQ(1, coupledInsertHead(list, (void*) 1));
+
+	// Build 1 2 3 4 5
+	EXPECT_EQ((void*) 1, coupledBegin(list, &cursor));
+	EXPECT_EQ(1, coupledInsertAfter(&cursor, (void*) 2));
+	EXPECT_EQ((void*) 2, coupledNext(&cursor));
+	EXPECT_EQ((void*) 4, coupledNext(&cursor));
+	EXPECT_EQ(1, coupledInsertBefore(&cursor, (void*) 3));
+	EXPECT_EQ((void*) 4, coupledGet(&cursor));
+	EXPECT_EQ(NULL, coupledNext(&cursor));
+	EXPECT_EQ(1, coupledInsertBefore(&cursor, (void*) 5));
+	coupledEnd(&cursor);
+	EXPECT_EQ(5, coupledGetSize(list));
+
+	uintptr_t expected = 1;
+	for (void* d = coupledBegin(list, &cursor); d != NULL; d = coupledNext(&cursor))
+		EXPECT_EQ((void*) expected++, d);
+	EXPECT_EQ(6u, expected);
+	coupledEnd(&cursor);
+
+	// Removing moves the cursor forward
+	coupledBegin(list, &cursor);
+	EXPECT_EQ((void*) 1, coupledRemoveForward(&cursor));
+	EXPECT_EQ((void*) 2, coupledGet(&cursor));
+	coupledNext(&cursor);
+	coupledNext(&cursor);
+	coupledNext(&cursor);
+	EXPECT_EQ((void*) 5, coupledRemoveForward(&cursor));
+	EXPECT_EQ(NULL, coupledGet(&cursor));
+	coupledEnd(&cursor);
+	EXPECT_EQ(3, coupledGetSize(list));
+
+	drain(list);
+	EXPECT_EQ(0, coupledGetSize(list));
+	destroyCoupledList(list);
+}
+
+TEST(CoupledList, EditsAtDifferentPositions)
+{
+	// Lay out WORKERS markers GAP nodes apart
+	CoupledList* list = create_coupledlist();
+	CoupledCursor cursor;
+	coupledBegin(list, &cursor);
+	for (uintptr_t w = 0; w < WORKERS; w++)
+		for (uintptr_t i = 0; i < GAP; i++)
+			coupledInsertBefore(&cursor, (void*) (i == GAP - 1 ? (w + 1) * 1000 : 1));
+	coupledEnd(&cursor);
+
+	pthread_t threads[WORKERS];
+	WorkerArgs args[WORKERS];
+	for (int w = 0; w < WORKERS; w++) {
+		args[w].list = list;
+		args[w].marker = (w + 1) * 1000;
+		pthread_create(&threads[w], NULL, worker_thread, &args[w]);
+	}
+	for (int w = 0; w < WORKERS; w++)
+		pthread_join(threads[w], NULL);
+
+	// Every insert was matched by a remove, and the links are consistent
+	EXPECT_EQ(WORKERS * GAP, coupledGetSize(list));
+	int count = 0;
+	for (LLNode* node = list->head.node.next; node != &list->tail.node; node = node->next) {
+		ASSERT_EQ(node, node->next->previous);
+		count++;
+	}
+	EXPECT_EQ(WORKERS * GAP, count);
+
+	drain(list);
+	destroyCoupledList(list);
+}
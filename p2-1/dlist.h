@@ -0,0 +1,313 @@
+/** @file dlist.h */
+#ifndef DLIST_H
+#define DLIST_H
+
+#include <new>
+#include <stddef.h>
+#include <utility>
+
+
+/********************************************
+ * Typed list library                       *
+ * A header-only C++ version of the         *
+ * doublely linked list that stores each    *
+ * element inside its node, so there is one *
+ * allocation per element and no void*. It  *
+ * keeps the same head/tail/current cursor  *
+ * model and function names.                *
+ ********************************************/
+
+
+/**
+ * This structure represents a single typed list node. The element is stored
+ * in the node itself.
+ */
+template <typename T>
+struct DListNode {
+    /** A pointer to the previous node in the list. NULL if there is no previous node. */
+    DListNode* previous;
+
+    /** A pointer to the next node in the list. NULL if there is no next node. */
+    DListNode* next;
+
+    /** The element */
+    T value;
+
+    /** Construct the element in place from the given arguments */
+    template <typename... Args>
+    explicit DListNode(Args&&... args)
+        : previous(NULL), next(NULL), value(std::forward<Args>(args)...) {}
+};
+
+
+/**
+ * This class represents an entire typed list. Like DLinkedList, the current
+ * pointer is the cursor that the get, insert and remove functions work from.
+ * Getters return a pointer to the element in its node, or NULL. The list can
+ * be moved but not copied.
+ */
+template <typename T>
+class DList {
+public:
+    typedef DListNode<T> Node;
+
+    /** The head pointer for the list (points to the first node) */
+    Node* head;
+
+    /** The tail pointer for the list (points to the last node) */
+    Node* tail;
+
+    /** The current pointer for the list (points to the current node) */
+    Node* current;
+
+    /** The number of nodes in the list */
+    int size;
+
+    DList() : head(NULL), tail(NULL), current(NULL), size(0) {}
+
+    DList(DList&& other)
+        : head(other.head), tail(other.tail), current(other.current), size(other.size) {
+        other.head = other.tail = other.current = NULL;
+        other.size = 0;
+    }
+
+    DList& operator=(DList&& other) {
+        if (this != &other) {
+            clear();
+            head = other.head;
+            tail = other.tail;
+            current = other.current;
+            size = other.size;
+            other.head = other.tail = other.current = NULL;
+            other.size = 0;
+        }
+        return *this;
+    }
+
+    DList(const DList&) = delete;
+    DList& operator=(const DList&) = delete;
+
+    /** Destroy every element and free every node */
+    ~DList() { clear(); }
+
+    /**
+     * emplaceHead
+     *
+     * Construct a new element as the head of the list. Do not update the
+     * current node.
+     *
+     * @param args The arguments to T's constructor
+     * @return A pointer to the new element, or NULL if allocation failed
+     */
+    template <typename... Args>
+    T* emplaceHead(Args&&... args) {
+        Node* node = new (std::nothrow) Node(std::forward<Args>(args)...);
+        if (node == NULL) return NULL;
+        link(NULL, node, head);
+        return &node->value;
+    }
+
+    /**
+     * emplaceTail
+     *
+     * Construct a new element as the tail of the list. Do not update the
+     * current node.
+     *
+     * @param args The arguments to T's constructor
+     * @return A pointer to the new element, or NULL if allocation failed
+     */
+    template <typename... Args>
+    T* emplaceTail(Args&&... args) {
+        Node* node = new (std::nothrow) Node(std::forward<Args>(args)...);
+        if (node == NULL) return NULL;
+        link(tail, node, NULL);
+        return &node->value;
+    }
+
+    /**
+     * emplaceAfter
+     *
+     * Construct a new element immediately after the current node. If the
+     * current node is NULL, this method fails. Do not update the current node.
+     *
+     * @param args The arguments to T's constructor
+     * @return A pointer to the new element, or NULL if the current pointer is
+     *         NULL or allocation failed
+     */
+    template <typename... Args>
+    T* emplaceAfter(Args&&... args) {
+        if (current == NULL) return NULL;
+        Node* node = new (std::nothrow) Node(std::forward<Args>(args)...);
+        if (node == NULL) return NULL;
+        link(current, node, current->next);
+        return &node->value;
+    }
+
+    /**
+     * emplaceBefore
+     *
+     * Construct a new element immediately before the current node. If the
+     * current node is NULL, this method fails. Do not update the current node.
+     *
+     * @param args The arguments to T's constructor
+     * @return A pointer to the new element, or NULL if the current pointer is
+     *         NULL or allocation failed
+     */
+    template <typename... Args>
+    T* emplaceBefore(Args&&... args) {
+        if (current == NULL) return NULL;
+        Node* node = new (std::nothrow) Node(std::forward<Args>(args)...);
+        if (node == NULL) return NULL;
+        link(current->previous, node, current);
+        return &node->value;
+    }
+
+    /** Copy or move an element in as the head. 1 on success, 0 if allocation failed. */
+    int insertHead(const T& value) { return emplaceHead(value) != NULL; }
+    int insertHead(T&& value) { return emplaceHead(std::move(value)) != NULL; }
+
+    /** Copy or move an element in as the tail. 1 on success, 0 if allocation failed. */
+    int insertTail(const T& value) { return emplaceTail(value) != NULL; }
+    int insertTail(T&& value) { return emplaceTail(std::move(value)) != NULL; }
+
+    /** Copy or move an element in after the current node. 0 if current is NULL. */
+    int insertAfter(const T& value) { return emplaceAfter(value) != NULL; }
+    int insertAfter(T&& value) { return emplaceAfter(std::move(value)) != NULL; }
+
+    /** Copy or move an element in before the current node. 0 if current is NULL. */
+    int insertBefore(const T& value) { return emplaceBefore(value) != NULL; }
+    int insertBefore(T&& value) { return emplaceBefore(std::move(value)) != NULL; }
+
+    /**
+     * deleteBackward
+     *
+     * Destroy the current element and its node, and move the current pointer
+     * backward.
+     *
+     * @return the new current element, or NULL if the current pointer is NULL
+     */
+    T* deleteBackward() {
+        if (current == NULL) return NULL;
+        Node* previous = current->previous;
+        delete unlink(current);
+        current = previous;
+        return getCurrent();
+    }
+
+    /**
+     * deleteForward
+     *
+     * Destroy the current element and its node, and move the current pointer
+     * forward.
+     *
+     * @return the new current element, or NULL if the current pointer is NULL
+     */
+    T* deleteForward() {
+        if (current == NULL) return NULL;
+        Node* next = current->next;
+        delete unlink(current);
+        current = next;
+        return getCurrent();
+    }
+
+    /**
+     * removeBackward
+     *
+     * Move the current element out into the caller's object, free its node,
+     * and move the current pointer backward.
+     *
+     * @param out Where to move the element. NULL just destroys it.
+     * @return 1 if an element was removed, 0 if the current pointer is NULL
+     */
+    int removeBackward(T* out) {
+        if (current == NULL) return 0;
+        if (out != NULL) *out = std::move(current->value);
+        deleteBackward();
+        return 1;
+    }
+
+    /**
+     * removeForward
+     *
+     * Move the current element out into the caller's object, free its node,
+     * and move the current pointer forward.
+     *
+     * @param out Where to move the element. NULL just destroys it.
+     * @return 1 if an element was removed, 0 if the current pointer is NULL
+     */
+    int removeForward(T* out) {
+        if (current == NULL) return 0;
+        if (out != NULL) *out = std::move(current->value);
+        deleteForward();
+        return 1;
+    }
+
+    /** Destroy every element and leave the list empty */
+    void clear() {
+        Node* node = head;
+        while (node != NULL) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+        head = tail = current = NULL;
+        size = 0;
+    }
+
+    /** Move current to the head and return its element, or NULL if empty */
+    T* getHead() {
+        current = head;
+        return getCurrent();
+    }
+
+    /** Move current to the tail and return its element, or NULL if empty */
+    T* getTail() {
+        current = tail;
+        return getCurrent();
+    }
+
+    /** Return the current element, or NULL if current == NULL */
+    T* getCurrent() {
+        return current != NULL ? &current->value : NULL;
+    }
+
+    /** Move current forward and return its element, or NULL past the tail */
+    T* getNext() {
+        if (current == NULL) return NULL;
+        current = current->next;
+        return getCurrent();
+    }
+
+    /** Move current backward and return its element, or NULL past the head */
+    T* getPrevious() {
+        if (current == NULL) return NULL;
+        current = current->previous;
+        return getCurrent();
+    }
+
+    /** Return the number of elements */
+    int getSize() const { return size; }
+
+private:
+    // Link a node in between two neighbors, either of which may be NULL
+    void link(Node* previous, Node* node, Node* next) {
+        node->previous = previous;
+        node->next = next;
+        if (previous != NULL) previous->next = node;
+        else head = node;
+        if (next != NULL) next->previous = node;
+        else tail = node;
+        size++;
+    }
+
+    // Unlink a node, leaving the current pointer alone
+    Node* unlink(Node* node) {
+        if (node->previous != NULL) node->previous->next = node->next;
+        else head = node->next;
+        if (node->next != NULL) node->next->previous = node->previous;
+        else tail = node->previous;
+        size--;
+        return node;
+    }
+};
+#endif
@@ -0,0 +1,62 @@
+// DLinkedList with a malloc'd payload per element against DList<T> with the
+// payload stored in the node: building, walking and destroying a list
+//
+// Usage: ./dlist_bench [elements]
+//
+// The DLinkedList side allocates each payload the way make_items does, so it
+// makes two allocations per element and follows one more pointer per access.
+
+#include <stdlib.h>
+#include "bench_util.h"
+#include "dlist.h"
+#include "doublely_linked_list.h"
+
+struct Item {
+	long key;
+	double weight;
+	Item(long k, double w) : key(k), weight(w) {}
+};
+
+int main(int argc, char** argv)
+{
+	long n = argc > 1 ? atol(argv[1]) : 2000000;
+	double sum = 0, typedSum = 0;
+
+	// void* payloads
+	double begin = benchSeconds();
+	DLinkedList* list = create_dlinkedlist();
+	for (long i = 0; i < n; i++) {
+		Item* item = (Item*) malloc(sizeof(Item));
+		item->key = i;
+		item->weight = i * 0.5;
+		insertTail(list, item);
+	}
+	double built = benchSeconds();
+	for (int pass = 0; pass < 4; pass++)
+		for (Item* item = (Item*) getHead(list); item != NULL; item = (Item*) getNext(list))
+			sum += item->key + item->weight;
+	double walked = benchSeconds();
+	destroyList(list);
+	double destroyed = benchSeconds();
+	benchReport("DLinkedList build  (2 allocs/element)", n, built - begin);
+	benchReport("DLinkedList walk", 4.0 * n, walked - built);
+	benchReport("DLinkedList destroy", n, destroyed - walked);
+
+	// Inline payloads
+	begin = benchSeconds();
+	DList<Item>* typed = new DList<Item>;
+	for (long i = 0; i < n; i++) typed->emplaceTail(i, i * 0.5);
+	built = benchSeconds();
+	for (int pass = 0; pass < 4; pass++)
+		for (Item* item = typed->getHead(); item != NULL; item = typed->getNext())
+			typedSum += item->key + item->weight;
+	walked = benchSeconds();
+	delete typed;
+	destroyed = benchSeconds();
+	benchReport("DList<Item> build  (1 alloc/element)", n, built - begin);
+	benchReport("DList<Item> walk", 4.0 * n, walked - built);
+	benchReport("DList<Item> destroy", n, destroyed - walked);
+
+	// Both walks saw the same elements in the same order
+	return sum != typedSum;
+}
@@ -0,0 +1,103 @@
+#include <memory>
+#include <string>
+#include "dlist.h"
+#include "gtest/gtest.h"
+
+
+// Counts how its instances are made and destroyed
+struct Tracked {
+	static int live, copies, moves;
+	int key;
+	explicit Tracked(int k) : key(k) { live++; }
+	Tracked(const Tracked& o) : key(o.key) { live++; copies++; }
+	Tracked(Tracked&& o) : key(o.key) { o.key = -1; live++; moves++; }
+	Tracked& operator=(Tracked&& o) { key = o.key; o.key = -1; moves++; return *this; }
+	~Tracked() { live--; }
+};
+int Tracked::live, Tracked::copies, Tracked::moves;
+
+
+TEST(DList, CursorMatchesDLinkedList)
+{
+	DList<int> list;
+	EXPECT_EQ(NULL, list.getHead());
+	list.insertTail(2);
+	list.insertHead(1);
+	list.insertTail(4);
+	EXPECT_EQ(3, list.getSize());
+
+	// Insert around the current node without moving it
+	list.getTail();
+	ASSERT_TRUE(list.emplaceBefore(3) != NULL);
+	EXPECT_EQ(4, *list.getCurrent());
+	list.current = NULL;
+	EXPECT_EQ(0, list.insertAfter(5));
+
+	// Walk both ways
+	int expected = 1;
+	for (int* v = list.getHead(); v != NULL; v = list.getNext()) EXPECT_EQ(expected++, *v);
+	for (int* v = list.getTail(); v != NULL; v = list.getPrevious()) EXPECT_EQ(--expected, *v);
+
+	// Delete from the middle in each direction
+	list.getHead(); list.getNext();
+	EXPECT_EQ(3, *list.deleteForward());
+	EXPECT_EQ(1, *list.deleteBackward());
+	EXPECT_EQ(NULL, list.deleteBackward());
+	EXPECT_EQ(4, *list.getHead());
+	EXPECT_EQ(1, list.getSize());
+	EXPECT_EQ(list.head, list.tail);
+}
+
+TEST(DList, ElementsLiveInTheirNodes)
+{
+	DList<Tracked> list;
+	Tracked* t = list.emplaceTail(7);
+	ASSERT_TRUE(t != NULL);
+	EXPECT_EQ(&list.tail->value, t);
+
+	// Emplacing constructs in place; inserting an rvalue moves instead of copying
+	Tracked::copies = Tracked::moves = 0;
+	list.emplaceHead(6);
+	list.insertTail(Tracked(8));
+	EXPECT_EQ(0, Tracked::copies);
+	EXPECT_EQ(1, Tracked::moves);
+	Tracked lvalue(9);
+	list.insertTail(lvalue);
+	EXPECT_EQ(1, Tracked::copies);
+	EXPECT_EQ(5, Tracked::live);
+
+	// Removing moves the element out and destroys the one left in the node
+	Tracked out(0);
+	list.getHead();
+	EXPECT_EQ(1, list.removeForward(&out));
+	EXPECT_EQ(6, out.key);
+	EXPECT_EQ(7, list.getCurrent()->key);
+	EXPECT_EQ(5, Tracked::live);
+	list.clear();
+	EXPECT_EQ(0, list.getSize());
+	EXPECT_EQ(2, Tracked::live);
+}
+
+TEST(DList, MoveOnlyElementsAndLists)
+{
+	DList<std::unique_ptr<std::string> > list;
+	list.emplaceTail(new std::string("a"));
+	list.insertTail(std::unique_ptr<std::string>(new std::string("b")));
+
+	// Moving the list hands over its nodes and cursor
+	list.getTail();
+	DList<std::unique_ptr<std::string> > moved(std::move(list));
+	EXPECT_EQ(0, list.getSize());
+	EXPECT_EQ(NULL, list.getHead());
+	EXPECT_EQ(2, moved.getSize());
+	EXPECT_EQ("b", **moved.getCurrent());
+
+	std::unique_ptr<std::string> out;
+	EXPECT_EQ(1, moved.removeBackward(&out));
+	EXPECT_EQ("b", *out);
+	EXPECT_EQ("a", **moved.getCurrent());
+
+	list = std::move(moved);
+	EXPECT_EQ(1, list.getSize());
+	EXPECT_EQ(0, moved.removeForward(NULL));
+}
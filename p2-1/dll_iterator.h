@@ -0,0 +1,138 @@
+/** @file dll_iterator.h */
+#ifndef DLLITERATOR_H
+#define DLLITERATOR_H
+
+#include <iterator>
+#include <stddef.h>
+#include "doublely_linked_list.h"
+
+
+/********************************************
+ * Doublely linked list iterators           *
+ * A header-only C++ adapter that walks a   *
+ * DLinkedList with STL bidirectional       *
+ * iterators instead of the list's current  *
+ * pointer, so standard algorithms and      *
+ * range-for work on it. Iterating never    *
+ * moves the current pointer.               *
+ ********************************************/
+
+
+/**
+ * A bidirectional iterator over a DLinkedList's data pointers. It holds the
+ * node it is at, or NULL past the tail, and the list so that the end can be
+ * stepped back from. Dereferencing gives the node's data pointer.
+ */
+class DLLIterator {
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef void* value_type;
+    typedef ptrdiff_t difference_type;
+    typedef void** pointer;
+    typedef void*& reference;
+
+    /** The node the iterator is at. NULL past the tail. */
+    LLNode* node;
+
+    /** The list being walked */
+    DLinkedList* list;
+
+    DLLIterator() : node(NULL), list(NULL) {}
+    DLLIterator(LLNode* n, DLinkedList* l) : node(n), list(l) {}
+
+    reference operator*() const { return node->data; }
+    pointer operator->() const { return &node->data; }
+
+    DLLIterator& operator++() {
+        node = node->next;
+        return *this;
+    }
+
+    DLLIterator operator++(int) {
+        DLLIterator old = *this;
+        node = node->next;
+        return old;
+    }
+
+    /** Stepping back from the end moves to the tail */
+    DLLIterator& operator--() {
+        node = node != NULL ? node->previous : list->tail;
+        return *this;
+    }
+
+    DLLIterator operator--(int) {
+        DLLIterator old = *this;
+        --*this;
+        return old;
+    }
+
+    bool operator==(const DLLIterator& other) const { return node == other.node; }
+    bool operator!=(const DLLIterator& other) const { return node != other.node; }
+};
+
+
+/**
+ * A range over a DLinkedList. It does not own the list; it only borrows it
+ * for begin/end and for inserting and erasing at an iterator.
+ *
+ *     for (void* data : DLinkedListRange(list)) ...
+ */
+class DLinkedListRange {
+public:
+    typedef DLLIterator iterator;
+    typedef std::reverse_iterator<DLLIterator> reverse_iterator;
+
+    /** The list being walked */
+    DLinkedList* list;
+
+    explicit DLinkedListRange(DLinkedList* l) : list(l) {}
+
+    iterator begin() const { return iterator(list->head, list); }
+    iterator end() const { return iterator(NULL, list); }
+    reverse_iterator rbegin() const { return reverse_iterator(end()); }
+    reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+    /**
+     * insert
+     *
+     * Insert a new node immediately before the iterator's node, or as the
+     * tail if it is the end. Do not update the current node.
+     *
+     * @param position Where to insert
+     * @param data A void pointer to the data to insert
+     * @return an iterator at the new node, or end() if allocation failed
+     */
+    iterator insert(iterator position, void* data) const {
+        // insertTail gives no result, so a failed insert shows in the size
+        int size = getSize(list);
+        if (position.node == NULL) {
+            insertTail(list, data);
+            if (getSize(list) == size) return end();
+            return iterator(list->tail, list);
+        }
+
+        // insertBefore works from the current pointer, so borrow it
+        LLNode* saved = list->current;
+        list->current = position.node;
+        int inserted = insertBefore(list, data);
+        list->current = saved;
+        if (!inserted) return end();
+        return iterator(position.node->previous, list);
+    }
+
+    /**
+     * erase
+     *
+     * Remove the iterator's node from the list. The data is not freed. If the
+     * node is the current node, the current pointer moves forward.
+     *
+     * @param position The node to remove. Must not be the end.
+     * @return an iterator at the node that followed it
+     */
+    iterator erase(iterator position) const {
+        LLNode* next = position.node->next;
+        releaseNode(list, detachNode(list, position.node));
+        return iterator(next, list);
+    }
+};
+#endif
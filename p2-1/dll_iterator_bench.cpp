@@ -0,0 +1,72 @@
+// Summing a DLinkedList's data with a hand-written loop over node->next
+// against the iterator adapter: range-for, std::accumulate and reverse
+// iterators, plus the getNext cursor walk for reference
+//
+// Usage: ./dll_iterator_bench [elements] [passes]
+//
+// The iterator rows should match the hand-written loop; the adapter compiles
+// down to the same pointer chase.
+
+#include <numeric>
+#include <stdint.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "dll_iterator.h"
+
+static uintptr_t add(uintptr_t s, void* d) { return s + (uintptr_t) d; }
+
+int main(int argc, char** argv)
+{
+	long n = argc > 1 ? atol(argv[1]) : 1000000;
+	int passes = argc > 2 ? atoi(argv[2]) : 20;
+	uint64_t seed = 42;
+	DLinkedList* list = create_dlinkedlist();
+	for (long i = 0; i < n; i++) insertTail(list, (void*) (uintptr_t) benchRandom(&seed));
+	DLinkedListRange range(list);
+	double ops = (double) n * passes;
+	uintptr_t sums[5] = {0};
+
+	// One untimed pass so the first row does not pay for cold caches
+	uintptr_t warm = 0;
+	for (LLNode* node = list->head; node != NULL; node = node->next) warm += (uintptr_t) node->data;
+
+	double begin = benchSeconds();
+	for (int p = 0; p < passes; p++) {
+		LLNode* node = list->head;
+		while (node != NULL) {
+			sums[0] += (uintptr_t) node->data;
+			node = node->next;
+		}
+	}
+	benchReport("while loop over node->next", ops, benchSeconds() - begin);
+
+	begin = benchSeconds();
+	for (int p = 0; p < passes; p++)
+		for (void* data : range) sums[1] += (uintptr_t) data;
+	benchReport("range-for", ops, benchSeconds() - begin);
+
+	begin = benchSeconds();
+	for (int p = 0; p < passes; p++)
+		sums[2] = std::accumulate(range.begin(), range.end(), sums[2], add);
+	benchReport("std::accumulate", ops, benchSeconds() - begin);
+
+	begin = benchSeconds();
+	for (int p = 0; p < passes; p++)
+		for (DLinkedListRange::reverse_iterator it = range.rbegin(); it != range.rend(); ++it)
+			sums[3] += (uintptr_t) *it;
+	benchReport("reverse iterators", ops, benchSeconds() - begin);
+
+	begin = benchSeconds();
+	for (int p = 0; p < passes; p++)
+		for (void* data = getHead(list); data != NULL; data = getNext(list))
+			sums[4] += (uintptr_t) data;
+	benchReport("getHead/getNext cursor", ops, benchSeconds() - begin);
+
+	// Remove every node without freeing the borrowed data pointers
+	benchDrain(list);
+	destroyList(list);
+
+	for (int i = 1; i < 5; i++)
+		if (sums[i] != sums[0]) return 1;
+	return warm * passes != sums[0];
+}
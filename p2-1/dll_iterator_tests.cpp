@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <numeric>
+#include <stdint.h>
+#include "dll_iterator.h"
+#include "test_util.h"
+#include "gtest/gtest.h"
+
+
+// Build a list holding the small integers 1..n as data pointers
+static DLinkedList* make_list(uintptr_t n)
+{
+	DLinkedList* list = create_dlinkedlist();
+	for (uintptr_t i = 1; i <= n; i++) insertTail(list, (void*) i);
+	return list;
+}
+
+
+TEST(DLLIterator, RangeForLeavesCursorAlone)
+{
+	DLinkedList* list = make_list(5);
+	getTail(list);
+	uintptr_t expected = 1;
+	for (void* data : DLinkedListRange(list)) EXPECT_EQ(expected++, (uintptr_t) data);
+	EXPECT_EQ(6u, expected);
+	EXPECT_EQ((void*) 5, getCurrent(list));
+
+	DLinkedListRange empty(create_dlinkedlist());
+	EXPECT_TRUE(empty.begin() == empty.end());
+	EXPECT_TRUE(empty.rbegin() == empty.rend());
+	destroyList(empty.list);
+	testDrain(list);
+	destroyList(list);
+}
+
+TEST(DLLIterator, StandardAlgorithms)
+{
+	DLinkedList* list = make_list(10);
+	DLinkedListRange range(list);
+
+	uintptr_t sum = std::accumulate(range.begin(), range.end(), (uintptr_t) 0,
+			[](uintptr_t s, void* d) { return s + (uintptr_t) d; });
+	EXPECT_EQ(55u, sum);
+	DLLIterator found = std::find_if(range.begin(), range.end(),
+			[](void* d) { return (uintptr_t) d % 7 == 0; });
+	EXPECT_EQ((void*) 7, *found);
+	EXPECT_EQ(10, std::distance(range.begin(), range.end()));
+
+	// Walking backward, including stepping back from the end
+	uintptr_t expected = 10;
+	for (auto it = range.rbegin(); it != range.rend(); ++it) EXPECT_EQ(expected--, (uintptr_t) *it);
+	EXPECT_EQ((void*) 10, *std::prev(range.end()));
+
+	// Writes through the iterator reach the nodes
+	std::reverse(range.begin(), range.end());
+	EXPECT_EQ((void*) 10, getHead(list));
+	EXPECT_EQ((void*) 1, getTail(list));
+	testDrain(list);
+	destroyList(list);
+}
+
+TEST(DLLIterator, InsertAndErase)
+{
+	DLinkedList* list = make_list(3);
+	DLinkedListRange range(list);
+
+	// Insert before the head, in the middle and at the end
+	DLLIterator it = range.insert(range.begin(), (void*) 10);
+	EXPECT_EQ(list->head, it.node);
+	it = range.insert(std::next(range.begin(), 2), (void*) 20);
+	EXPECT_EQ((void*) 20, *it);
+	it = range.insert(range.end(), (void*) 30);
+	EXPECT_EQ(list->tail, it.node);
+	EXPECT_EQ(6, getSize(list));
+
+	// Erase the odd data while walking, keeping the current pointer valid
+	getHead(list);
+	for (it = range.begin(); it != range.end(); ) {
+		if ((uintptr_t) *it % 2) it = range.erase(it);
+		else ++it;
+	}
+	EXPECT_EQ(4, getSize(list));
+	EXPECT_EQ((void*) 10, getCurrent(list));
+	uintptr_t expected[] = {10, 20, 2, 30};
+	int i = 0;
+	for (void* data : range) EXPECT_EQ(expected[i++], (uintptr_t) data);
+	EXPECT_EQ((void*) 30, getTail(list));
+	testDrain(list);
+	destroyList(list);
+}
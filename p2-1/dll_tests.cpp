@@ -1,4 +1,5 @@
 #include "doublely_linked_list.h"
+#include "test_util.h"
 #include "gtest/gtest.h"
 
 
@@ -824,3 +825,590 @@ TEST(Remove, Forward_Multiple)
 	destroyList(list);
 	free(m[2]);
 }
+
+TEST(Node, Detach_Reinsert)
+{
+	// Create list items for test
+	size_t num_items = 3;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// Insert 3 items at the tail (list is now [0, 1, 2])
+	DLinkedList* list = create_dlinkedlist();
+	for (int i = 0; i < 3; i++)
+		insertTail(list, m[i]);
+
+	// Detach the middle node while it is current
+	ASSERT_EQ(m[0], getHead(list));
+	ASSERT_EQ(m[1], getNext(list));
+	LLNode* node = detachNode(list, list->current);
+	EXPECT_EQ(m[1], node->data);
+	EXPECT_EQ(2, getSize(list));
+	EXPECT_EQ(m[2], getCurrent(list));
+
+	// Relink it at the head (list is now [1, 0, 2])
+	insertNodeHead(list, node);
+	EXPECT_EQ(3, getSize(list));
+	ASSERT_EQ(m[1], getHead(list));
+	EXPECT_EQ(m[0], getNext(list));
+	EXPECT_EQ(m[2], getNext(list));
+	EXPECT_EQ(NULL, getNext(list));
+	ASSERT_EQ(m[2], getTail(list));
+	EXPECT_EQ(m[0], getPrevious(list));
+	EXPECT_EQ(m[1], getPrevious(list));
+	EXPECT_EQ(NULL, getPrevious(list));
+
+	// Delete the list
+	destroyList(list);
+}
+
+TEST(Node, Append_List)
+{
+	// Create list items for test
+	size_t num_items = 4;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// Build [0, 1] and [2, 3]
+	DLinkedList* list = create_dlinkedlist();
+	DLinkedList* other = create_dlinkedlist();
+	insertTail(list, m[0]);
+	insertTail(list, m[1]);
+	insertTail(other, m[2]);
+	insertTail(other, m[3]);
+
+	// Appending an empty list changes nothing
+	DLinkedList* empty = create_dlinkedlist();
+	appendList(list, empty);
+	EXPECT_EQ(2, getSize(list));
+
+	// Splice the second list on (list is now [0, 1, 2, 3])
+	getHead(other);
+	appendList(list, other);
+	EXPECT_EQ(4, getSize(list));
+	EXPECT_EQ(0, getSize(other));
+	EXPECT_EQ(NULL, getHead(other));
+	EXPECT_EQ(NULL, getCurrent(other));
+	ASSERT_EQ(m[0], getHead(list));
+	for (size_t i = 1; i < num_items; i++)
+		EXPECT_EQ(m[i], getNext(list));
+	EXPECT_EQ(NULL, getNext(list));
+	ASSERT_EQ(m[3], getTail(list));
+	for (int i = num_items - 2; i >= 0; i--)
+		EXPECT_EQ(m[i], getPrevious(list));
+
+	// Appending into an empty list takes the whole chain
+	appendList(empty, list);
+	EXPECT_EQ(4, getSize(empty));
+	EXPECT_EQ(m[0], getHead(empty));
+	EXPECT_EQ(m[3], getTail(empty));
+
+	// Delete the lists
+	destroyList(list);
+	destroyList(other);
+	destroyList(empty);
+}
+
+TEST(Index, Find)
+{
+	// Create list items for test
+	size_t num_items = 3;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// Index a list that already holds one item, then add the rest
+	DLinkedList* list = create_dlinkedlist();
+	insertTail(list, m[0]);
+	ASSERT_EQ(1, enableIndex(list));
+	insertHead(list, m[1]);
+	getHead(list);
+	insertAfter(list, m[2]);
+
+	// Every item should be found without moving the current pointer
+	for (int i = 0; i < 3; i++) {
+		LLNode* node = findByData(list, m[i]);
+		ASSERT_TRUE(node != NULL);
+		EXPECT_EQ(m[i], node->data);
+	}
+	EXPECT_EQ(m[1], getCurrent(list));
+	EXPECT_EQ(NULL, findByData(list, list));
+
+	// Delete the list
+	destroyList(list);
+}
+
+TEST(Index, Remove)
+{
+	// Create list items for test
+	size_t num_items = 3;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// Insert 3 items at the tail (list is now [0, 1, 2])
+	DLinkedList* list = create_dlinkedlist();
+	ASSERT_EQ(1, enableIndex(list));
+	for (int i = 0; i < 3; i++)
+		insertTail(list, m[i]);
+
+	// Remove the middle item while it is current
+	ASSERT_EQ(m[0], getHead(list));
+	ASSERT_EQ(m[1], getNext(list));
+	EXPECT_EQ(m[1], removeByData(list, m[1]));
+	EXPECT_EQ(2, getSize(list));
+	EXPECT_EQ(m[2], getCurrent(list));
+	EXPECT_EQ(NULL, findByData(list, m[1]));
+	EXPECT_EQ(NULL, removeByData(list, m[1]));
+
+	// Items removed through the cursor should leave the index too
+	EXPECT_EQ(m[2], removeForward(list));
+	EXPECT_EQ(NULL, findByData(list, m[2]));
+	EXPECT_EQ(m[0], findByData(list, m[0])->data);
+
+	// Delete the list
+	destroyList(list);
+	free(m[1]);
+	free(m[2]);
+}
+
+TEST(Index, MoveToFront)
+{
+	// Create list items for test
+	size_t num_items = 3;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// Insert 3 items at the tail (list is now [0, 1, 2])
+	DLinkedList* list = create_dlinkedlist();
+	ASSERT_EQ(1, enableIndex(list));
+	for (int i = 0; i < 3; i++)
+		insertTail(list, m[i]);
+
+	// Move the tail to the front (list is now [2, 0, 1])
+	ASSERT_EQ(m[2], getTail(list));
+	ASSERT_EQ(1, moveToFront(list, m[2]));
+	EXPECT_EQ(m[2], getCurrent(list));
+	EXPECT_EQ(3, getSize(list));
+	EXPECT_EQ(0, moveToFront(list, list));
+
+	// Check forward links
+	ASSERT_EQ(m[2], getHead(list));
+	EXPECT_EQ(m[0], getNext(list));
+	EXPECT_EQ(m[1], getNext(list));
+	EXPECT_EQ(NULL, getNext(list));
+
+	// Check backward links
+	ASSERT_EQ(m[1], getTail(list));
+	EXPECT_EQ(m[0], getPrevious(list));
+	EXPECT_EQ(m[2], getPrevious(list));
+	EXPECT_EQ(NULL, getPrevious(list));
+
+	// Delete the list
+	destroyList(list);
+}
+
+TEST(Index, Many)
+{
+	// Create enough items to make the index grow several times
+	size_t num_items = 1000;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	DLinkedList* list = create_dlinkedlist();
+	ASSERT_EQ(1, enableIndex(list));
+	for (size_t i = 0; i < num_items; i++)
+		insertTail(list, m[i]);
+
+	// Remove every other item, then check what is left
+	for (size_t i = 0; i < num_items; i += 2)
+		ASSERT_EQ(m[i], removeByData(list, m[i]));
+	EXPECT_EQ((int) num_items / 2, getSize(list));
+	for (size_t i = 0; i < num_items; i++) {
+		LLNode* node = findByData(list, m[i]);
+		if (i % 2 == 0) EXPECT_EQ(NULL, node);
+		else ASSERT_TRUE(node != NULL && node->data == m[i]);
+	}
+
+	// Delete the list
+	destroyList(list);
+	for (size_t i = 0; i < num_items; i += 2)
+		free(m[i]);
+}
+
+TEST(Index, Append)
+{
+	// Create list items for test
+	size_t num_items = 4;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// Index both lists, then splice one onto the other
+	DLinkedList* list = create_dlinkedlist();
+	DLinkedList* other = create_dlinkedlist();
+	ASSERT_EQ(1, enableIndex(list));
+	ASSERT_EQ(1, enableIndex(other));
+	insertTail(list, m[0]);
+	insertTail(list, m[1]);
+	insertTail(other, m[2]);
+	insertTail(other, m[3]);
+	appendList(list, other);
+
+	// The moved items are found in their new list only
+	for (size_t i = 0; i < num_items; i++)
+		ASSERT_TRUE(findByData(list, m[i]) != NULL);
+	EXPECT_EQ(NULL, findByData(other, m[2]));
+	EXPECT_EQ(m[3], removeByData(list, m[3]));
+	EXPECT_EQ(3, getSize(list));
+
+	// Delete the lists
+	destroyList(list);
+	destroyList(other);
+	free(m[3]);
+}
+
+TEST(Small, Caller_Owned)
+{
+	// Create list items for test
+	size_t num_items = 2;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// A list on the stack works like a heap one, and can be reused after clearing
+	DLinkedList list;
+	init_dlinkedlist(&list);
+	EXPECT_EQ(NULL, getHead(&list));
+	insertTail(&list, m[0]);
+	insertHead(&list, NULL);
+	EXPECT_EQ(2, getSize(&list));
+	clearList(&list);
+	EXPECT_EQ(0, getSize(&list));
+	EXPECT_EQ(NULL, getHead(&list));
+	insertTail(&list, m[1]);
+	EXPECT_EQ(m[1], getHead(&list));
+
+	// Delete the list
+	clearList(&list);
+}
+
+TEST(Small, Inline_Then_Heap)
+{
+	// Create list items for test
+	size_t num_items = DLL_INLINE_NODES + 2;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// The first nodes take the inline slots, the rest come from the heap
+	SmallDLinkedList small;
+	init_smalldlinkedlist(&small);
+	DLinkedList* list = &small.list;
+	for (size_t i = 0; i < num_items; i++) insertTail(list, m[i]);
+	EXPECT_EQ((int) num_items, getSize(list));
+	EXPECT_EQ(&small.slots[0], list->head);
+	EXPECT_EQ(&small.slots[DLL_INLINE_NODES - 1], list->head->next->next->next);
+	EXPECT_TRUE(list->tail < small.slots || list->tail >= small.slots + DLL_INLINE_NODES);
+
+	// A removed inline node frees its slot for the next insert
+	getHead(list);
+	getNext(list);
+	EXPECT_EQ(m[1], removeForward(list));
+	insertHead(list, m[1]);
+	EXPECT_EQ(&small.slots[1], list->head);
+	ASSERT_EQ(m[1], getHead(list));
+	ASSERT_EQ(m[0], getNext(list));
+	for (size_t i = 2; i < num_items; i++) EXPECT_EQ(m[i], getNext(list));
+
+	// Delete the list
+	clearList(list);
+	EXPECT_EQ(0, list->inlineUsed);
+}
+
+TEST(Small, Append_Copies_Inline)
+{
+	// Create list items for test
+	size_t num_items = 3;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// Splice a small list holding inline nodes onto a heap list
+	SmallDLinkedList small;
+	init_smalldlinkedlist(&small);
+	DLinkedList* list = create_dlinkedlist();
+	ASSERT_EQ(1, enableIndex(list));
+	insertTail(list, m[0]);
+	insertTail(&small.list, m[1]);
+	insertTail(&small.list, m[2]);
+	getTail(&small.list);
+	ASSERT_EQ(1, appendList(list, &small.list));
+	EXPECT_EQ(0, small.list.inlineUsed);
+	EXPECT_EQ(NULL, getHead(&small.list));
+
+	// None of the moved nodes are the small list's slots, and the index found them
+	for (LLNode* node = list->head; node != NULL; node = node->next)
+		EXPECT_TRUE(node < small.slots || node >= small.slots + DLL_INLINE_NODES);
+	ASSERT_EQ(m[0], getHead(list));
+	EXPECT_EQ(m[1], getNext(list));
+	EXPECT_EQ(m[2], getNext(list));
+	EXPECT_EQ(m[2], getTail(list));
+	EXPECT_EQ(m[1], getPrevious(list));
+	EXPECT_EQ(list->tail, findByData(list, m[2]));
+
+	// Delete the lists
+	destroyList(list);
+	clearList(&small.list);
+}
+
+struct Point { int x, y, z, w; };
+
+TEST(Value, Insert_And_Get)
+{
+	// Each payload is copied into its node
+	DLinkedList* list = create_dlinkedlist();
+	Point a = {1, 2, 3, 4}, b = {5, 6, 7, 8};
+	Point* copy = (Point*) insertTailValue(list, &a, sizeof(Point));
+	ASSERT_TRUE(copy != NULL);
+	EXPECT_NE(&a, copy);
+	EXPECT_EQ(copy, (Point*) ((LLValueNode*) list->head)->value);
+	EXPECT_EQ(1u, ((LLValueNode*) list->head)->inValue);
+	insertHeadValue(list, &b, sizeof(Point));
+	a.x = 100;
+
+	// The getters return pointers into the nodes
+	Point* p = (Point*) getHead(list);
+	EXPECT_EQ(5, p->x);
+	p = (Point*) getNext(list);
+	EXPECT_EQ(1, p->x);
+	EXPECT_EQ(4, p->w);
+
+	// Insert around the current node (list is now [b, c, a, d])
+	Point c = {9, 9, 9, 9}, d = {0, 0, 0, 1};
+	EXPECT_TRUE(insertBeforeValue(list, &c, sizeof(Point)) != NULL);
+	EXPECT_TRUE(insertAfterValue(list, &d, sizeof(Point)) != NULL);
+	EXPECT_EQ(4, getSize(list));
+	EXPECT_EQ(9, ((Point*) getPrevious(list))->x);
+	EXPECT_EQ(1, ((Point*) getTail(list))->w);
+	list->current = NULL;
+	EXPECT_EQ(NULL, insertAfterValue(list, &d, sizeof(Point)));
+
+	// Delete the list, which frees the value nodes whole
+	destroyList(list);
+}
+
+TEST(Value, Remove_And_Mixed)
+{
+	// Create list items for test
+	size_t num_items = 2;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// A list that already holds pointer nodes takes no values
+	DLinkedList* list = create_dlinkedlist();
+	int values[] = {10, 20, 30};
+	insertTail(list, m[0]);
+	EXPECT_TRUE(insertTailValue(list, &values[0], sizeof(int)) == NULL);
+	EXPECT_EQ(0, enableValues(list));
+	getHead(list);
+	EXPECT_EQ(m[0], removeForward(list));
+
+	// Value nodes and pointer nodes can share a list that holds values
+	EXPECT_EQ(1, enableValues(list));
+	insertTail(list, m[0]);
+	for (int i = 0; i < 3; i++) insertTailValue(list, &values[i], sizeof(int));
+	insertTail(list, m[1]);
+
+	// Copy a value out while removing it
+	int out = 0;
+	getHead(list);
+	getNext(list);
+	EXPECT_EQ(1, removeForwardValue(list, &out, sizeof(int)));
+	EXPECT_EQ(10, out);
+	EXPECT_EQ(20, *(int*) getCurrent(list));
+	EXPECT_EQ(1, removeBackwardValue(list, &out, sizeof(int)));
+	EXPECT_EQ(20, out);
+	EXPECT_EQ(m[0], getCurrent(list));
+
+	// deleteForward frees a pointer node's data and a value node whole
+	EXPECT_EQ(30, *(int*) deleteForward(list));
+	EXPECT_EQ(m[1], deleteForward(list));
+	EXPECT_EQ(1, getSize(list));
+	list->current = NULL;
+	EXPECT_EQ(0, removeForwardValue(list, &out, sizeof(int)));
+
+	// Delete the list
+	destroyList(list);
+}
+
+TEST(Int, Insert_And_Get)
+{
+	// Ints are stored in the data slot, so nothing is boxed
+	DLinkedList* list = create_dlinkedlist();
+	insertTailInt(list, 2);
+	insertHeadInt(list, 1);
+	insertTailInt(list, -4);
+	getTail(list);
+	EXPECT_EQ(1, insertBeforeInt(list, 3));
+	EXPECT_EQ(1, insertAfterInt(list, INTPTR_MAX / 2));
+	EXPECT_EQ(5, getSize(list));
+
+	// Walk forward and back with the typed getters
+	intptr_t expected[] = {1, 2, 3, -4, INTPTR_MAX / 2};
+	intptr_t v = 0;
+	int i = 0;
+	for (int ok = getHeadInt(list, &v); ok; ok = getNextInt(list, &v)) EXPECT_EQ(expected[i++], v);
+	EXPECT_EQ(5, i);
+	for (int ok = getTailInt(list, &v); ok; ok = getPreviousInt(list, &v)) EXPECT_EQ(expected[--i], v);
+	EXPECT_EQ(0, i);
+
+	// The plain getters still walk the list, since a tagged int is never NULL
+	for (void* d = getHead(list); d != NULL; d = getNext(list)) i++;
+	EXPECT_EQ(5, i);
+	EXPECT_TRUE(isIntData(getHead(list)));
+	EXPECT_EQ(0, dataToInt(intToData(0)));
+	EXPECT_EQ(INTPTR_MIN / 2, dataToInt(intToData(INTPTR_MIN / 2)));
+
+	// Delete the list, which frees no data
+	destroyList(list);
+}
+
+TEST(Int, Remove_And_Mixed)
+{
+	// Create list items for test
+	size_t num_items = 2;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// Ints and pointer nodes can share a list
+	DLinkedList* list = create_dlinkedlist();
+	insertTail(list, m[0]);
+	for (intptr_t i = 10; i <= 30; i += 10) insertTailInt(list, i);
+	insertTail(list, m[1]);
+
+	// A pointer node is not an int
+	intptr_t out = 0;
+	EXPECT_EQ(0, getHeadInt(list, &out));
+	EXPECT_EQ(0, removeForwardInt(list, &out));
+
+	// Read an int out while removing it
+	EXPECT_EQ(1, getNextInt(list, &out));
+	EXPECT_EQ(1, removeForwardInt(list, &out));
+	EXPECT_EQ(10, out);
+	EXPECT_EQ(1, removeBackwardInt(list, &out));
+	EXPECT_EQ(20, out);
+	EXPECT_EQ(m[0], getCurrent(list));
+
+	// deleteForward frees a pointer node's data but not an int
+	EXPECT_EQ(intToData(30), deleteForward(list));
+	EXPECT_EQ(m[1], deleteForward(list));
+	EXPECT_EQ(1, getSize(list));
+	list->current = NULL;
+	EXPECT_EQ(0, removeBackwardInt(list, &out));
+
+	// Delete the list
+	destroyList(list);
+}
+
+// Key extractor for the key tests: the first int of the data
+static uint64_t first_int(void* data)
+{
+	return (uint64_t) *(int*) data;
+}
+
+TEST(Key, Find_And_Sort)
+{
+	// Keys are only cached once the list has an extractor
+	int keys[] = {5, 3, 9, 3, 1, 7};
+	DLinkedList* list = create_dlinkedlist();
+	EXPECT_EQ(NULL, findByKey(list, 5));
+	EXPECT_EQ(0, sortByKey(list));
+	ASSERT_EQ(1, enableKeys(list, first_int));
+	for (int i = 0; i < 6; i++) insertTail(list, &keys[i]);
+
+	// findByKey returns the first node with the key
+	EXPECT_EQ(&keys[1], findByKey(list, 3)->data);
+	EXPECT_EQ(&keys[5], findByKey(list, 7)->data);
+	EXPECT_EQ(NULL, findByKey(list, 4));
+
+	// Sorting keeps equal keys in order and the current pointer on its node
+	getHead(list);
+	getNext(list);
+	EXPECT_EQ(1, sortByKey(list));
+	EXPECT_EQ(&keys[1], getCurrent(list));
+	int* expected[] = {&keys[4], &keys[1], &keys[3], &keys[0], &keys[5], &keys[2]};
+	int i = 0;
+	for (void* d = getHead(list); d != NULL; d = getNext(list)) EXPECT_EQ(expected[i++], d);
+	EXPECT_EQ(6, i);
+	for (void* d = getTail(list); d != NULL; d = getPrevious(list)) EXPECT_EQ(expected[--i], d);
+	EXPECT_EQ(0, i);
+
+	// The extractor can't change while the list holds nodes
+	EXPECT_EQ(0, enableKeys(list, NULL));
+	EXPECT_EQ(1, enableKeys(list, first_int));
+
+	// Delete the list without freeing the borrowed keys
+	testDrain(list);
+	EXPECT_EQ(1, enableKeys(list, NULL));
+	destroyList(list);
+}
+
+TEST(Key, Sort_Lengths)
+{
+	// Odd and even lengths leave runs of every width to merge
+	for (int n = 0; n < 40; n++) {
+		DLinkedList* list = create_dlinkedlist();
+		enableKeys(list, first_int);
+		for (int i = 0; i < n; i++) {
+			int value = (i * 7) % 11;
+			insertHeadValue(list, &value, sizeof(int));
+		}
+		EXPECT_EQ(1, sortByKey(list));
+		EXPECT_EQ(n, getSize(list));
+
+		int previous = -1, count = 0;
+		for (void* d = getHead(list); d != NULL; d = getNext(list)) {
+			EXPECT_LE(previous, *(int*) d);
+			previous = *(int*) d;
+			count++;
+		}
+		EXPECT_EQ(n, count);
+		if (n != 0) {
+			EXPECT_EQ(previous, *(int*) list->tail->data);
+		}
+
+		// Delete the list, which frees the value nodes whole
+		destroyList(list);
+	}
+}
+
+TEST(Key, Mixed_Kinds)
+{
+	// Create list items for test
+	size_t num_items = 1;
+	ListItem* m[num_items];
+	make_items(m, num_items);
+
+	// A keyed list holds value nodes with the payload after the key and the
+	// inValue word
+	DLinkedList* list = create_dlinkedlist();
+	enableKeys(list, first_int);
+	int value = 42;
+	int* copy = (int*) insertTailValue(list, &value, sizeof(int));
+	ASSERT_TRUE(copy != NULL);
+	EXPECT_EQ((char*) list->tail + sizeof(LLKeyNode) + sizeof(uintptr_t), (char*) copy);
+	EXPECT_EQ(copy, findByKey(list, 42)->data);
+
+	// Lists with different extractors can't be joined, nor can a keyed list
+	// that holds values and one that doesn't
+	DLinkedList* plain = create_dlinkedlist();
+	insertTail(plain, m[0]);
+	EXPECT_EQ(0, appendList(list, plain));
+	EXPECT_EQ(0, appendList(plain, list));
+	getHead(plain);
+	deleteForward(plain);
+	ASSERT_EQ(1, enableKeys(plain, first_int));
+	insertTail(plain, calloc(1, sizeof(int)));
+	EXPECT_EQ(0, appendList(list, plain));
+	EXPECT_EQ(1, getSize(list));
+	EXPECT_EQ(1, getSize(plain));
+
+	// Delete the lists
+	destroyList(list);
+	destroyList(plain);
+}
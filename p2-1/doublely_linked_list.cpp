@@ -3,25 +3,168 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "doublely_linked_list.h"
+#include "node_alloc.h"
+#include "node_index.h"
+
+// Record a newly linked node in the list's data index, if it has one. If the
+// index cannot grow it is dropped, and lookups fall back to scanning the list.
+static void index_node(DLinkedList* dLinkedList, LLNode* node) {
+	if (dLinkedList->index == NULL) return;
+	if (!nodeIndexPut(dLinkedList->index, (uintptr_t) node->data, node)) disableIndex(dLinkedList);
+}
+
+// The bytes before a node's inValue word: the links, plus the key if the list
+// caches keys
+static size_t base_header(DLinkedList* dLinkedList) {
+	return dLinkedList->keyOf != NULL ? sizeof(LLKeyNode) : sizeof(LLNode);
+}
+
+// The bytes before a node's payload: the base header, plus the inValue word
+// if the list holds values
+static size_t node_header(DLinkedList* dLinkedList) {
+	return base_header(dLinkedList) + (dLinkedList->holdsValues ? sizeof(uintptr_t) : 0);
+}
+
+// A node holds its payload only if the list holds values and the node's
+// inValue word says so
+static int is_value_node(DLinkedList* dLinkedList, LLNode* node) {
+	return dLinkedList->holdsValues && *(uintptr_t *) ((char *) node + base_header(dLinkedList)) != 0;
+}
+
+// Cache the key of a new node, if the list caches keys, and record whether it
+// holds its payload, if the list holds values
+static void set_header(DLinkedList* dLinkedList, LLNode* node, uintptr_t inValue) {
+	if (dLinkedList->keyOf != NULL) ((LLKeyNode *) node)->key = dLinkedList->keyOf(node->data);
+	if (dLinkedList->holdsValues) *(uintptr_t *) ((char *) node + base_header(dLinkedList)) = inValue;
+}
+
+// Create a value node holding a copy of the payload
+static LLNode* create_value_node(DLinkedList* dLinkedList, const void* value, size_t size) {
+	if (!enableValues(dLinkedList)) return NULL;
+	size_t header = node_header(dLinkedList);
+	LLNode* node = (LLNode *) malloc(header + size);
+	if (node == NULL) return NULL;
+	memcpy((char *) node + header, value, size);
+	node->next = NULL;
+	node->previous = NULL;
+	node->data = (char *) node + header;
+	set_header(dLinkedList, node, 1);
+	return node;
+}
+
+// Remove the current node with the given function and free its data, unless
+// the data lives in the node
+static void free_data(DLinkedList* dLinkedList, void* (*remove)(DLinkedList*)) {
+	LLNode* node = dLinkedList->current;
+	int owned = node != NULL && !is_value_node(dLinkedList, node) && !isIntData(node->data);
+	void* data = remove(dLinkedList);
+	if (owned) free(data);
+}
+
+// Take a node for the list: a node with the list's header if it caches keys
+// or holds values, a free inline slot if it has one, or a node from
+// create_llnode once they are all in use
+static LLNode* take_node(DLinkedList* dLinkedList, void* data) {
+	if (dLinkedList->keyOf != NULL || dLinkedList->holdsValues) {
+		LLNode* node = (LLNode *) malloc(node_header(dLinkedList));
+		if (node == NULL) return NULL;
+		node->next = NULL;
+		node->previous = NULL;
+		node->data = data;
+		set_header(dLinkedList, node, 0);
+		return node;
+	}
+
+	unsigned freeSlots = ~dLinkedList->inlineUsed & ((1u << dLinkedList->inlineSlots) - 1);
+	if (freeSlots == 0) return create_llnode(data);
+
+	int slot = __builtin_ctz(freeSlots);
+	dLinkedList->inlineUsed |= 1u << slot;
+	LLNode* node = &((SmallDLinkedList *) dLinkedList)->slots[slot];
+	node->next = NULL;
+	node->previous = NULL;
+	node->data = data;
+	return node;
+}
+
+// Give back a node from take_node
+static void give_node(DLinkedList* dLinkedList, LLNode* node) {
+	if (dLinkedList->inlineSlots != 0) {
+		LLNode* slots = ((SmallDLinkedList *) dLinkedList)->slots;
+		if (node >= slots && node < slots + dLinkedList->inlineSlots) {
+			dLinkedList->inlineUsed &= ~(1u << (node - slots));
+			return;
+		}
+	}
+	if (dLinkedList->keyOf != NULL || dLinkedList->holdsValues) free(node);
+	else free_llnode(node);
+}
+
+// Swap every node in the source's inline slots for one the destination owns,
+// so the chain can leave the source. Either all are swapped or none are.
+static int move_inline_nodes(DLinkedList* dest, DLinkedList* src) {
+	// Take the replacements first, so running out changes nothing
+	LLNode* spare[DLL_INLINE_NODES];
+	int count = __builtin_popcount(src->inlineUsed);
+	for (int i = 0; i < count; i++) {
+		spare[i] = take_node(dest, NULL);
+		if (spare[i] == NULL) {
+			while (i--) give_node(dest, spare[i]);
+			return 0;
+		}
+	}
+
+	// Copy each used slot into its replacement and relink the neighbors
+	LLNode* slots = ((SmallDLinkedList *) src)->slots;
+	for (int slot = 0, i = 0; slot < src->inlineSlots; slot++) {
+		if (!(src->inlineUsed & (1u << slot))) continue;
+		LLNode* node = spare[i++];
+		*node = slots[slot];
+		if (node->previous != NULL) (node->previous)->next = node;
+		else src->head = node;
+		if (node->next != NULL) (node->next)->previous = node;
+		else src->tail = node;
+		if (src->current == &slots[slot]) src->current = node;
+	}
+	src->inlineUsed = 0;
+	return 1;
+}
 
 DLinkedList* create_dlinkedlist(void) {
 	// Create space for the new linked list
 	DLinkedList* newList = (DLinkedList *) malloc(sizeof(DLinkedList));
+	if (newList == NULL) return NULL;
 
 	// Initialize all parameters to 0/NULL
-	newList->head = NULL;
-	newList->tail = NULL;
-	newList->current = NULL;
-	newList->size = 0;
+	init_dlinkedlist(newList);
 
 	// Return the new list
 	return newList;
 }
 
+void init_dlinkedlist(DLinkedList* dLinkedList) {
+	dLinkedList->head = NULL;
+	dLinkedList->tail = NULL;
+	dLinkedList->current = NULL;
+	dLinkedList->size = 0;
+	dLinkedList->inlineSlots = 0;
+	dLinkedList->inlineUsed = 0;
+	dLinkedList->index = NULL;
+	dLinkedList->keyOf = NULL;
+	dLinkedList->holdsValues = 0;
+}
+
+void init_smalldlinkedlist(SmallDLinkedList* small) {
+	init_dlinkedlist(&small->list);
+	small->list.inlineSlots = DLL_INLINE_NODES;
+}
+
 LLNode* create_llnode(void* data) {
-	// Create a pointer to the new node
-	LLNode *node = (LLNode *) malloc(sizeof(LLNode));
+	// Take a node from this thread's cache of free nodes
+	LLNode *node = nodeAlloc();
+	if (node == NULL) return NULL;
 
 	// Initialize the values to NULL and the input
 	node->next = NULL;
@@ -32,56 +175,59 @@ LLNode* create_llnode(void* data) {
 	return node;
 }
 
-void insertHead(DLinkedList* dLinkedList, void* data) {
-	// Create a new node
-	LLNode* newNode = create_llnode(data);
+void free_llnode(LLNode* node) {
+	nodeFree(node);
+}
 
-	// If there were no nodes to begin with, correct the pointers
-	dLinkedList->size++;
-	if (dLinkedList->head == NULL){
-		dLinkedList->head = newNode;
-		dLinkedList->tail = newNode;
-	} else {
-		newNode->next = dLinkedList->head;
-		(dLinkedList->head)->previous = newNode;
-		dLinkedList->head = newNode;
-	}
+void insertHead(DLinkedList* dLinkedList, void* data) {
+	// Create a new node and link it in, unless allocation failed
+	LLNode *node = take_node(dLinkedList, data);
+	if (node != NULL) insertNodeHead(dLinkedList, node);
 }
 
 void insertTail(DLinkedList* dLinkedList, void* data) {
-	// Create a new node
-	LLNode *node = create_llnode(data);
+	// Create a new node and link it in, unless allocation failed
+	LLNode *node = take_node(dLinkedList, data);
+	if (node != NULL) insertNodeTail(dLinkedList, node);
+}
 
-	// If there were no nodes to begin with, correct the pointers
+// Link a new node in right after the current node, which must not be NULL
+static void link_after(DLinkedList* dLinkedList, LLNode* node) {
+	// Insert the new node into the list
 	dLinkedList->size++;
-	if (dLinkedList->tail == NULL) {
-		dLinkedList->head = node;
-		dLinkedList->tail = node;
-	} else {
-		node->previous = dLinkedList->tail;
-		(dLinkedList->tail)->next = node;
-		dLinkedList->tail = node;
-	}
+	node->next = (dLinkedList->current)->next;
+	node->previous = dLinkedList->current;
+	if (node->next != NULL) (node->next)->previous = node;
+	if (node->previous != NULL) (node->previous)->next = node;
+
+	// Check to make sure we set the tail pointer if we are the new tail
+	if (node->previous == dLinkedList->tail) dLinkedList->tail = node;
+	index_node(dLinkedList, node);
+}
 
+// Link a new node in right before the current node, which must not be NULL
+static void link_before(DLinkedList* dLinkedList, LLNode* node) {
+	// Insert the new node into the list
+	dLinkedList->size++;
+	node->next = dLinkedList->current;
+	node->previous = (dLinkedList->current)->previous;
+	if (node->next != NULL) (node->next)->previous = node;
+	if (node->previous != NULL) (node->previous)->next = node;
+
+	// Check to make sure we set the head pointer if we are the new head
+	if (node->next == dLinkedList->head) dLinkedList->head = node;
+	index_node(dLinkedList, node);
 }
 
 int insertAfter(DLinkedList* dLinkedList, void* newData) {
 	// Only update if the current pointer is not NULL
 	if (dLinkedList->current != NULL) {
 		// Create the new node
-		LLNode *node = create_llnode(newData);
+		LLNode *node = take_node(dLinkedList, newData);
+		if (node == NULL) return 0;
 
-		// Insert the new node into the list
-		dLinkedList->size++;
-		node->next = (dLinkedList->current)->next;
-		node->previous = dLinkedList->current;
-		if (node->next != NULL) (node->next)->previous = node;
-		if (node->previous != NULL) (node->previous)->next = node;
-
-		// Check to make sure we set the tail pointer if we are the new tail
-		if (node->previous == dLinkedList->tail) dLinkedList->tail = node;
-
-		// Return the success code
+		// Insert the new node into the list, and return the success code
+		link_after(dLinkedList, node);
 		return 1;
 	}
 
@@ -92,19 +238,11 @@ int insertBefore(DLinkedList* dLinkedList, void* newData) {
 	// Only update if the current pointer is not NULL
 	if (dLinkedList->current != NULL) {
 		// Create the new node
-		LLNode *node = create_llnode(newData);
-
-		// Insert the new node into the list
-		dLinkedList->size++;
-		node->next = dLinkedList->current;
-		node->previous = (dLinkedList->current)->previous;
-		if (node->next != NULL) (node->next)->previous = node;
-		if (node->previous != NULL) (node->previous)->next = node;
-
-		// Check to make sure we set the head pointer if we are the new head
-		if (node->next == dLinkedList->head) dLinkedList->head = node;
+		LLNode *node = take_node(dLinkedList, newData);
+		if (node == NULL) return 0;
 
-		// Return the success code
+		// Insert the new node into the list, and return the success code
+		link_before(dLinkedList, node);
 		return 1;
 	}
 
@@ -112,8 +250,9 @@ int insertBefore(DLinkedList* dLinkedList, void* newData) {
 }
 
 void* deleteBackward(DLinkedList* dLinkedList) {
-	// Remove the node and go backward
-	free(removeBackward(dLinkedList));
+	// Remove the node and go backward. A value node's data goes with it, and an
+	// int stored in the data slot has nothing to free.
+	free_data(dLinkedList, removeBackward);
 
 	// Only return the current node's data if it is non-null
 	if (dLinkedList->current != NULL) return (dLinkedList->current)->data;
@@ -123,8 +262,9 @@ void* deleteBackward(DLinkedList* dLinkedList) {
 }
 
 void* deleteForward(DLinkedList* dLinkedList) {
-	// Remove the node and go forward
-	free(removeForward(dLinkedList));
+	// Remove the node and go forward. A value node's data goes with it, and an
+	// int stored in the data slot has nothing to free.
+	free_data(dLinkedList, removeForward);
 
 	// Only return the current node's data if it is non-null
 	if (dLinkedList->current != NULL) return (dLinkedList->current)->data;
@@ -136,26 +276,13 @@ void* deleteForward(DLinkedList* dLinkedList) {
 void* removeBackward(DLinkedList* dLinkedList) {
 	// Only delete the current node if it is non-null
 	if (dLinkedList->current != NULL) {
-		// Check to see if the current node is the tail
-		if ((dLinkedList->current)->next == NULL) {
-			dLinkedList->tail = (dLinkedList->current)->previous;
-		}
-		
-		// Check to see if the current node is the head
-		if ((dLinkedList->current)->previous == NULL) {
-			dLinkedList->head = (dLinkedList->current)->next;
-		}
-
-		// Move the current pointer and set the next and previous pointers
-		if ((dLinkedList->current)->previous != NULL)
-			((dLinkedList->current)->previous)->next = (dLinkedList->current)->next;
-		if ((dLinkedList->current)->next != NULL)
-			((dLinkedList->current)->next)->previous = (dLinkedList->current)->previous;
+		// Unlink the node, then move the current pointer backward
 		LLNode *deletedNode = dLinkedList->current;
+		LLNode *previous = deletedNode->previous;
 		void *data = deletedNode->data;
-		dLinkedList->current = (dLinkedList->current)->previous;
-		free(deletedNode);
-		dLinkedList->size--;
+		detachNode(dLinkedList, deletedNode);
+		dLinkedList->current = previous;
+		give_node(dLinkedList, deletedNode);
 
 		// Return the current value only if the pointer is non-null
 		return data;
@@ -168,26 +295,11 @@ void* removeBackward(DLinkedList* dLinkedList) {
 void* removeForward(DLinkedList* dLinkedList) {
 	// Only delete the current node if it is non-null
 	if (dLinkedList->current != NULL) {
-		// Check to see if the current node is the tail
-		if ((dLinkedList->current)->next == NULL) {
-			dLinkedList->tail = (dLinkedList->current)->previous;
-		}
-		
-		// Check to see if the current node is the head
-		if ((dLinkedList->current)->previous == NULL) {
-			dLinkedList->head = (dLinkedList->current)->next;
-		}
-
-		// Move the current pointer and set the next and previous pointers
-		if ((dLinkedList->current)->previous != NULL)
-			((dLinkedList->current)->previous)->next = (dLinkedList->current)->next;
-		if ((dLinkedList->current)->next != NULL)
-			((dLinkedList->current)->next)->previous = (dLinkedList->current)->previous;
+		// Unlink the node; this moves the current pointer forward
 		LLNode *deletedNode = dLinkedList->current;
 		void *data = deletedNode->data;
-		dLinkedList->current = (dLinkedList->current)->next;
-		free(deletedNode);
-		dLinkedList->size--;
+		detachNode(dLinkedList, deletedNode);
+		give_node(dLinkedList, deletedNode);
 
 		// Return the current value only if the pointer is non-null
 		return data;
@@ -198,16 +310,19 @@ void* removeForward(DLinkedList* dLinkedList) {
 }
 
 void destroyList(DLinkedList* dLinkedList) {
-	// If the head isn't NULL, remove all of the following nodes
-	if(dLinkedList->head != NULL){
-		getHead(dLinkedList);
-		while(deleteForward(dLinkedList)){};
-	}
-
-	// Free up the list's memory
+	// Free up the nodes, then the list's memory
+	clearList(dLinkedList);
 	free(dLinkedList);
 }
 
+void clearList(DLinkedList* dLinkedList) {
+	// Delete every node from the head on. Checking current rather than the
+	// returned data keeps going past NULL data.
+	getHead(dLinkedList);
+	while (dLinkedList->current != NULL) deleteForward(dLinkedList);
+	disableIndex(dLinkedList);
+}
+
 void* getHead(DLinkedList* dLinkedList) {
 	// Update the current pointer
 	dLinkedList->current = dLinkedList->head;
@@ -263,3 +378,326 @@ void* getPrevious(DLinkedList* dLinkedList) {
 int getSize(DLinkedList* dLinkedList) {
 	return dLinkedList->size;
 }
+
+void insertNodeHead(DLinkedList* dLinkedList, LLNode* node) {
+	// If there were no nodes to begin with, correct the pointers
+	dLinkedList->size++;
+	node->previous = NULL;
+	if (dLinkedList->head == NULL) {
+		node->next = NULL;
+		dLinkedList->head = node;
+		dLinkedList->tail = node;
+	} else {
+		node->next = dLinkedList->head;
+		(dLinkedList->head)->previous = node;
+		dLinkedList->head = node;
+	}
+	index_node(dLinkedList, node);
+}
+
+void insertNodeTail(DLinkedList* dLinkedList, LLNode* node) {
+	// If there were no nodes to begin with, correct the pointers
+	dLinkedList->size++;
+	node->next = NULL;
+	if (dLinkedList->tail == NULL) {
+		node->previous = NULL;
+		dLinkedList->head = node;
+		dLinkedList->tail = node;
+	} else {
+		node->previous = dLinkedList->tail;
+		(dLinkedList->tail)->next = node;
+		dLinkedList->tail = node;
+	}
+	index_node(dLinkedList, node);
+}
+
+LLNode* detachNode(DLinkedList* dLinkedList, LLNode* node) {
+	// Fix up the head and tail pointers if the node is at either end
+	if (node->next == NULL) dLinkedList->tail = node->previous;
+	if (node->previous == NULL) dLinkedList->head = node->next;
+
+	// Link the neighbors to each other
+	if (node->previous != NULL) (node->previous)->next = node->next;
+	if (node->next != NULL) (node->next)->previous = node->previous;
+
+	// Move the current pointer off of the node
+	if (dLinkedList->current == node) dLinkedList->current = node->next;
+	if (dLinkedList->index != NULL) nodeIndexRemove(dLinkedList->index, (uintptr_t) node->data, node);
+	dLinkedList->size--;
+
+	// Clear the node's links and return it
+	node->next = NULL;
+	node->previous = NULL;
+	return node;
+}
+
+int enableValues(DLinkedList* dLinkedList) {
+	// The nodes already in the list have no room for the inValue word
+	if (dLinkedList->head != NULL && !dLinkedList->holdsValues) return 0;
+	dLinkedList->holdsValues = 1;
+	return 1;
+}
+
+void* insertHeadValue(DLinkedList* dLinkedList, const void* value, size_t size) {
+	LLNode* node = create_value_node(dLinkedList, value, size);
+	if (node == NULL) return NULL;
+	insertNodeHead(dLinkedList, node);
+	return node->data;
+}
+
+void* insertTailValue(DLinkedList* dLinkedList, const void* value, size_t size) {
+	LLNode* node = create_value_node(dLinkedList, value, size);
+	if (node == NULL) return NULL;
+	insertNodeTail(dLinkedList, node);
+	return node->data;
+}
+
+void* insertAfterValue(DLinkedList* dLinkedList, const void* value, size_t size) {
+	if (dLinkedList->current == NULL) return NULL;
+	LLNode* node = create_value_node(dLinkedList, value, size);
+	if (node == NULL) return NULL;
+	link_after(dLinkedList, node);
+	return node->data;
+}
+
+void* insertBeforeValue(DLinkedList* dLinkedList, const void* value, size_t size) {
+	if (dLinkedList->current == NULL) return NULL;
+	LLNode* node = create_value_node(dLinkedList, value, size);
+	if (node == NULL) return NULL;
+	link_before(dLinkedList, node);
+	return node->data;
+}
+
+int removeBackwardValue(DLinkedList* dLinkedList, void* out, size_t size) {
+	if (dLinkedList->current == NULL) return 0;
+	if (out != NULL) memcpy(out, (dLinkedList->current)->data, size);
+	deleteBackward(dLinkedList);
+	return 1;
+}
+
+int removeForwardValue(DLinkedList* dLinkedList, void* out, size_t size) {
+	if (dLinkedList->current == NULL) return 0;
+	if (out != NULL) memcpy(out, (dLinkedList->current)->data, size);
+	deleteForward(dLinkedList);
+	return 1;
+}
+
+void insertHeadInt(DLinkedList* dLinkedList, intptr_t value) {
+	insertHead(dLinkedList, intToData(value));
+}
+
+void insertTailInt(DLinkedList* dLinkedList, intptr_t value) {
+	insertTail(dLinkedList, intToData(value));
+}
+
+int insertAfterInt(DLinkedList* dLinkedList, intptr_t value) {
+	return insertAfter(dLinkedList, intToData(value));
+}
+
+int insertBeforeInt(DLinkedList* dLinkedList, intptr_t value) {
+	return insertBefore(dLinkedList, intToData(value));
+}
+
+// Read an int out of the data slot, if that is what it holds
+static int read_int(void* data, intptr_t* out) {
+	if (data == NULL || !isIntData(data)) return 0;
+	*out = dataToInt(data);
+	return 1;
+}
+
+int getHeadInt(DLinkedList* dLinkedList, intptr_t* out) {
+	return read_int(getHead(dLinkedList), out);
+}
+
+int getTailInt(DLinkedList* dLinkedList, intptr_t* out) {
+	return read_int(getTail(dLinkedList), out);
+}
+
+int getCurrentInt(DLinkedList* dLinkedList, intptr_t* out) {
+	return read_int(getCurrent(dLinkedList), out);
+}
+
+int getNextInt(DLinkedList* dLinkedList, intptr_t* out) {
+	return read_int(getNext(dLinkedList), out);
+}
+
+int getPreviousInt(DLinkedList* dLinkedList, intptr_t* out) {
+	return read_int(getPrevious(dLinkedList), out);
+}
+
+int removeForwardInt(DLinkedList* dLinkedList, intptr_t* out) {
+	if (!getCurrentInt(dLinkedList, out)) return 0;
+	removeForward(dLinkedList);
+	return 1;
+}
+
+int removeBackwardInt(DLinkedList* dLinkedList, intptr_t* out) {
+	if (!getCurrentInt(dLinkedList, out)) return 0;
+	removeBackward(dLinkedList);
+	return 1;
+}
+
+void releaseNode(DLinkedList* dLinkedList, LLNode* node) {
+	give_node(dLinkedList, node);
+}
+
+int appendList(DLinkedList* dest, DLinkedList* src) {
+	// Nothing to move from an empty list
+	if (src->head == NULL) return 1;
+
+	// Every node in a list has to be the same kind
+	if (src->keyOf != dest->keyOf || src->holdsValues != dest->holdsValues) return 0;
+
+	// Nodes in the source's inline slots have to stay behind, so copy them out
+	if (src->inlineUsed != 0 && !move_inline_nodes(dest, src)) return 0;
+
+	// Hand the index entries over to the destination
+	if (dest->index != NULL)
+		for (LLNode* node = src->head; node != NULL; node = node->next)
+			index_node(dest, node);
+	if (src->index != NULL) nodeIndexClear(src->index);
+
+	// Join the source chain onto the destination's tail
+	if (dest->tail != NULL) {
+		(dest->tail)->next = src->head;
+		(src->head)->previous = dest->tail;
+	} else {
+		dest->head = src->head;
+	}
+	dest->tail = src->tail;
+	dest->size += src->size;
+
+	// Leave the source empty
+	src->head = NULL;
+	src->tail = NULL;
+	src->current = NULL;
+	src->size = 0;
+	return 1;
+}
+
+int enableIndex(DLinkedList* dLinkedList) {
+	// Nothing to do if the list is already indexed
+	if (dLinkedList->index != NULL) return 1;
+	dLinkedList->index = create_nodeindex();
+	if (dLinkedList->index == NULL) return 0;
+
+	// Index every node the list already holds
+	for (LLNode* node = dLinkedList->head; node != NULL; node = node->next) {
+		index_node(dLinkedList, node);
+		if (dLinkedList->index == NULL) return 0;
+	}
+	return 1;
+}
+
+void disableIndex(DLinkedList* dLinkedList) {
+	if (dLinkedList->index != NULL) destroyNodeIndex(dLinkedList->index);
+	dLinkedList->index = NULL;
+}
+
+LLNode* findByData(DLinkedList* dLinkedList, void* data) {
+	// Use the index when we have one
+	if (dLinkedList->index != NULL) return nodeIndexGet(dLinkedList->index, (uintptr_t) data);
+
+	// Scan the list otherwise
+	for (LLNode* node = dLinkedList->head; node != NULL; node = node->next) {
+		if (node->data == data) return node;
+	}
+	return NULL;
+}
+
+void* removeByData(DLinkedList* dLinkedList, void* data) {
+	// Only remove the node if the data is in the list
+	LLNode* node = findByData(dLinkedList, data);
+	if (node == NULL) return NULL;
+
+	give_node(dLinkedList, detachNode(dLinkedList, node));
+	return data;
+}
+
+int moveToFront(DLinkedList* dLinkedList, void* data) {
+	// Only move the node if the data is in the list
+	LLNode* node = findByData(dLinkedList, data);
+	if (node == NULL) return 0;
+	if (node == dLinkedList->head) return 1;
+
+	// Relink the node at the head, keeping the current pointer where it was
+	LLNode* current = dLinkedList->current;
+	detachNode(dLinkedList, node);
+	insertNodeHead(dLinkedList, node);
+	dLinkedList->current = current;
+	return 1;
+}
+
+int enableKeys(DLinkedList* dLinkedList, DLLKeyFn keyOf) {
+	// The nodes already in the list have no room for a key
+	if (dLinkedList->head != NULL && keyOf != dLinkedList->keyOf) return 0;
+	dLinkedList->keyOf = keyOf;
+	return 1;
+}
+
+LLNode* findByKey(DLinkedList* dLinkedList, uint64_t key) {
+	// Only lists that cache keys can be searched by key
+	if (dLinkedList->keyOf == NULL) return NULL;
+
+	// Compare the cached keys, never the data
+	for (LLNode* node = dLinkedList->head; node != NULL; node = node->next) {
+		if (((LLKeyNode *) node)->key == key) return node;
+	}
+	return NULL;
+}
+
+// Merge two sorted chains linked through next onto the end of the output,
+// taking from the left on ties. Returns the new end of the output.
+static LLNode* merge_by_key(LLNode* tail, LLNode* left, LLNode* right) {
+	while (left != NULL && right != NULL) {
+		if (((LLKeyNode *) right)->key < ((LLKeyNode *) left)->key) {
+			tail->next = right;
+			right = right->next;
+		} else {
+			tail->next = left;
+			left = left->next;
+		}
+		tail = tail->next;
+	}
+	tail->next = left != NULL ? left : right;
+	while (tail->next != NULL) tail = tail->next;
+	return tail;
+}
+
+int sortByKey(DLinkedList* dLinkedList) {
+	// Only lists that cache keys can be sorted by key
+	if (dLinkedList->keyOf == NULL) return 0;
+
+	// Merge runs of width 1, 2, 4, ... bottom up, so no stack is needed
+	LLNode* chain = dLinkedList->head;
+	for (int width = 1; width < dLinkedList->size; width *= 2) {
+		LLNode head;
+		LLNode* tail = &head;
+		while (chain != NULL) {
+			// Cut two runs of the given width off the front of the chain
+			LLNode* left = chain;
+			LLNode* cut = left;
+			for (int i = 1; i < width && cut->next != NULL; i++) cut = cut->next;
+			LLNode* right = cut->next;
+			cut->next = NULL;
+			cut = right;
+			for (int i = 1; i < width && cut != NULL && cut->next != NULL; i++) cut = cut->next;
+			chain = cut != NULL ? cut->next : NULL;
+			if (cut != NULL) cut->next = NULL;
+
+			// Merge them onto the end of the output
+			tail = merge_by_key(tail, left, right);
+		}
+		chain = head.next;
+	}
+
+	// Restore the previous pointers and the ends
+	LLNode* previous = NULL;
+	dLinkedList->head = chain;
+	for (LLNode* node = chain; node != NULL; node = node->next) {
+		node->previous = previous;
+		previous = node;
+	}
+	dLinkedList->tail = previous;
+	return 1;
+}
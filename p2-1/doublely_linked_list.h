@@ -2,6 +2,12 @@
 #ifndef DOUBLELINKEDLIST_H
 #define DOUBLELINKEDLIST_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+/** The number of node slots in a SmallDLinkedList. At most 8. */
+#define DLL_INLINE_NODES 4
+
 
 /********************************************
  * Doublely Linked List library functions *
@@ -10,6 +16,12 @@
  ********************************************/
 
 
+/**
+ * A key extractor: returns the key a list caches for a node's data, such as
+ * a hash or a sort key. It is called once, when the node is inserted.
+ */
+typedef uint64_t (*DLLKeyFn)(void* data);
+
 /**
  * This structure represents an entire linked list.
  */
@@ -25,6 +37,21 @@ typedef struct dlinkedlist_t {
     
     /** The number of nodes in the list */
     int size;
+
+    /** The number of node slots in the SmallDLinkedList around this list. 0 for a plain list. */
+    unsigned char inlineSlots;
+
+    /** Bit i is set while slot i is linked into the list */
+    unsigned char inlineUsed;
+
+    /** Optional index from data pointers to nodes. NULL unless enableIndex was called. */
+    struct nodeindex_t* index;
+
+    /** Optional key extractor. While set, every node is an LLKeyNode. NULL unless enableKeys was called. */
+    DLLKeyFn keyOf;
+
+    /** 1 once the list holds value nodes. While set, every node records whether it holds its payload. */
+    unsigned char holdsValues;
 } DLinkedList;
 
 /**
@@ -41,6 +68,51 @@ typedef struct llnode_t {
     struct llnode_t* next;
 } LLNode;
 
+/**
+ * This structure represents a list with room for its first few nodes inside
+ * it. Nodes go in the slots while any is free, and come from create_llnode
+ * after that. Set one up with init_smalldlinkedlist and pass &small->list to
+ * the list functions. It must not be copied or moved while slots are in use.
+ */
+typedef struct smalldlinkedlist_t {
+    /** The list itself */
+    DLinkedList list;
+
+    /** The node slots */
+    LLNode slots[DLL_INLINE_NODES];
+} SmallDLinkedList;
+
+/**
+ * This structure represents a node in a list that holds values. The value
+ * functions make nodes that hold a copy of their data, with the node and the
+ * bytes in one allocation; the other inserts make nodes with an empty value.
+ * The list reads inValue to tell them apart, never the data pointer.
+ */
+typedef struct llvaluenode_t {
+    /** The links. data points at value if inValue is set. */
+    LLNode node;
+
+    /** 1 if the node holds its payload, 0 if data points elsewhere */
+    uintptr_t inValue;
+
+    /** The payload, aligned to a pointer */
+    unsigned char value[];
+} LLValueNode;
+
+/**
+ * This structure represents a node that caches a key next to its links, so a
+ * search can skip a node without touching its data. A list with a key
+ * extractor makes every node this way. If it also holds values, each node
+ * has an inValue word right after the key, and then its payload.
+ */
+typedef struct llkeynode_t {
+    /** The links */
+    LLNode node;
+
+    /** The key extractor's result for node.data */
+    uint64_t key;
+} LLKeyNode;
+
 
 /**
  * create_dlinkedlist
@@ -48,10 +120,32 @@ typedef struct llnode_t {
  * Creates a doublely liked list by allocating memory for it on the heap. Initialize the size to zero,
  * as well as head, current, and tail pointer to NULL
  *
- * @return A pointer to an empty dlinkedlist
+ * @return A pointer to an empty dlinkedlist, or NULL if allocation failed
  */
 DLinkedList* create_dlinkedlist(void);
 
+/**
+ * init_dlinkedlist
+ *
+ * Initialize caller-owned storage, such as a struct member or a local, as an
+ * empty doublely linked list. An all-zero DLinkedList is also an empty list.
+ * Tear it down with clearList rather than destroyList.
+ *
+ * @param dLinkedList A pointer to the storage for the list
+ */
+void init_dlinkedlist(DLinkedList* dLinkedList);
+
+/**
+ * init_smalldlinkedlist
+ *
+ * Initialize caller-owned storage as an empty list whose first
+ * DLL_INLINE_NODES nodes live in the storage itself. Tear it down with
+ * clearList.
+ *
+ * @param small A pointer to the storage for the list
+ */
+void init_smalldlinkedlist(SmallDLinkedList* small);
+
 /**
  * create_llnode
  *
@@ -60,16 +154,28 @@ DLinkedList* create_dlinkedlist(void);
  * data pointer
  *
  * @param data A void pointer to data the user is adding to the doublely linked list.
- * @return A pointer to the linked list node
+ * @return A pointer to the linked list node, or NULL if allocation failed
  */
 LLNode* create_llnode(void* data);
 
+/**
+ * free_llnode
+ *
+ * Helper function that gives back a node made by create_llnode. The node goes
+ * to the calling thread's cache of free nodes, so it may be freed on any
+ * thread. The data is not freed.
+ *
+ * @param node A pointer to the node, or NULL
+ */
+void free_llnode(LLNode* node);
+
 
 /**
  * insertHead
  *
  * Insert the data to the head of the doublely linked list.
  * Do not update the current node.
+ * If no node can be allocated, the list is left unchanged.
  *
  * @param dLinkedList A pointer to the doublely linked list
  * @param data A void pointer to data the user is adding to the doublely linked list.
@@ -83,6 +189,7 @@ void insertHead(DLinkedList* dLinkedList, void* data);
  *
  * Insert the data to the tail of the doublely linked list. 
  * Do not update the current node.
+ * If no node can be allocated, the list is left unchanged.
  *
  * @param dLinkedList A pointer to the doublely linked list
  * @param data A void pointer to data the user is adding to the doublely linked list.
@@ -100,7 +207,7 @@ void insertTail(DLinkedList* dLinkedList, void* data);
  * @param dLinkedList A pointer to the doublely linked list.
  * @param newData A void pointer to the new data to insert.
  * @return 1 if inserted the new data successfully
- *         0 if the current pointer is NULL
+ *         0 if the current pointer is NULL or allocation failed
  */
 int insertAfter(DLinkedList* dLinkedList, void* newData);
 
@@ -114,7 +221,7 @@ int insertAfter(DLinkedList* dLinkedList, void* newData);
  * @param dLinkedList A pointer to the doublely linked list
  * @param newData A void pointer to the new data to insert
  * @return 1 if insert the new data successfully
- *         0 if the current pointer is NULL
+ *         0 if the current pointer is NULL or allocation failed
  */
 int insertBefore(DLinkedList* dLinkedList, void* newData);
 
@@ -193,6 +300,18 @@ void* removeForward(DLinkedList* dLinkedList);
 void destroyList(DLinkedList* dLinkedList);
 
 
+/**
+ * clearList
+ *
+ * Empty the doublely linked list, freeing its nodes, data and index but not
+ * the list structure. This is the teardown for init_dlinkedlist and
+ * init_smalldlinkedlist, and leaves the list ready to use again.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ */
+void clearList(DLinkedList* dLinkedList);
+
+
 /**
  * getHead
  *
@@ -260,5 +379,460 @@ void* getPrevious(DLinkedList* dLinkedList);
  * @return  the size
  */
 int getSize(DLinkedList* dLinkedList);
+
+
+/********************************************
+ * Value functions                          *
+ * These copy a payload into the node       *
+ * itself, so each element is one           *
+ * allocation and getCurrent and friends    *
+ * return a pointer into the node. Only a   *
+ * list that holds values takes them; see   *
+ * enableValues. Delete value nodes with    *
+ * deleteForward, deleteBackward, clearList *
+ * or destroyList (which free node and      *
+ * payload together), or with               *
+ * removeForwardValue and                   *
+ * removeBackwardValue. removeForward,      *
+ * removeBackward and removeByData return a *
+ * pointer into the freed node.             *
+ ********************************************/
+
+
+/**
+ * enableValues
+ *
+ * Let the doublely linked list hold value nodes. From then on every node it
+ * makes records whether it holds its payload, and is malloc'd rather than
+ * taken from the node cache or a SmallDLinkedList's slots. The value inserts
+ * call this themselves, so the first of them must come while the list is
+ * empty unless this was called first.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @return 1 if the list holds values
+ *         0 if the list is not empty and does not hold values
+ */
+int enableValues(DLinkedList* dLinkedList);
+
+/**
+ * insertHeadValue
+ *
+ * Insert a copy of the payload as the head of the doublely linked list.
+ * Do not update the current node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param value A pointer to the payload to copy
+ * @param size The payload's size in bytes
+ * @return A pointer to the copy inside the new node, or NULL if the list does
+ *         not hold values or allocation failed
+ */
+void* insertHeadValue(DLinkedList* dLinkedList, const void* value, size_t size);
+
+/**
+ * insertTailValue
+ *
+ * Insert a copy of the payload as the tail of the doublely linked list.
+ * Do not update the current node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param value A pointer to the payload to copy
+ * @param size The payload's size in bytes
+ * @return A pointer to the copy inside the new node, or NULL if the list does
+ *         not hold values or allocation failed
+ */
+void* insertTailValue(DLinkedList* dLinkedList, const void* value, size_t size);
+
+/**
+ * insertAfterValue
+ *
+ * Insert a copy of the payload immediately after the current node.
+ * Do not update the current node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param value A pointer to the payload to copy
+ * @param size The payload's size in bytes
+ * @return A pointer to the copy inside the new node, or NULL if the current
+ *         pointer is NULL, the list does not hold values or allocation failed
+ */
+void* insertAfterValue(DLinkedList* dLinkedList, const void* value, size_t size);
+
+/**
+ * insertBeforeValue
+ *
+ * Insert a copy of the payload immediately before the current node.
+ * Do not update the current node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param value A pointer to the payload to copy
+ * @param size The payload's size in bytes
+ * @return A pointer to the copy inside the new node, or NULL if the current
+ *         pointer is NULL, the list does not hold values or allocation failed
+ */
+void* insertBeforeValue(DLinkedList* dLinkedList, const void* value, size_t size);
+
+/**
+ * removeBackwardValue
+ *
+ * Copy the current node's payload out, delete the node and move the current
+ * pointer backward.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param out Where to copy the payload, or NULL to drop it
+ * @param size The number of bytes to copy
+ * @return 1 if a node was removed, 0 if the current pointer is NULL
+ */
+int removeBackwardValue(DLinkedList* dLinkedList, void* out, size_t size);
+
+/**
+ * removeForwardValue
+ *
+ * Copy the current node's payload out, delete the node and move the current
+ * pointer forward.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param out Where to copy the payload, or NULL to drop it
+ * @param size The number of bytes to copy
+ * @return 1 if a node was removed, 0 if the current pointer is NULL
+ */
+int removeForwardValue(DLinkedList* dLinkedList, void* out, size_t size);
+
+
+/********************************************
+ * Int functions                            *
+ * These keep an integer in the data slot   *
+ * itself instead of boxing it. The low bit *
+ * tags the slot as an int, which no        *
+ * malloc'd pointer has, so the delete and  *
+ * destroy functions know not to free it.   *
+ * An int keeps 63 bits on a 64-bit build:  *
+ * INTPTR_MIN / 2 to INTPTR_MAX / 2.        *
+ ********************************************/
+
+
+/**
+ * intToData
+ *
+ * Tag an integer for storing in a node's data slot. The result is never NULL.
+ *
+ * @param value The integer, which must fit in one bit less than intptr_t
+ * @return the tagged data pointer
+ */
+static inline void* intToData(intptr_t value) {
+    return (void*) (((uintptr_t) value << 1) | 1);
+}
+
+/**
+ * isIntData
+ *
+ * @param data A node's data pointer
+ * @return 1 if the data slot holds a tagged integer, 0 if it holds a pointer
+ */
+static inline int isIntData(void* data) {
+    return (int) ((uintptr_t) data & 1);
+}
+
+/**
+ * dataToInt
+ *
+ * @param data A data pointer from intToData
+ * @return the integer it holds
+ */
+static inline intptr_t dataToInt(void* data) {
+    return (intptr_t) data >> 1;
+}
+
+/**
+ * insertHeadInt
+ *
+ * Insert an integer as the head of the doublely linked list.
+ * Do not update the current node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param value The integer to insert
+ */
+void insertHeadInt(DLinkedList* dLinkedList, intptr_t value);
+
+/**
+ * insertTailInt
+ *
+ * Insert an integer as the tail of the doublely linked list.
+ * Do not update the current node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param value The integer to insert
+ */
+void insertTailInt(DLinkedList* dLinkedList, intptr_t value);
+
+/**
+ * insertAfterInt
+ *
+ * Insert an integer immediately after the current node.
+ * Do not update the current node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param value The integer to insert
+ * @return 1 if inserted, 0 if the current pointer is NULL or allocation failed
+ */
+int insertAfterInt(DLinkedList* dLinkedList, intptr_t value);
+
+/**
+ * insertBeforeInt
+ *
+ * Insert an integer immediately before the current node.
+ * Do not update the current node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param value The integer to insert
+ * @return 1 if inserted, 0 if the current pointer is NULL or allocation failed
+ */
+int insertBeforeInt(DLinkedList* dLinkedList, intptr_t value);
+
+/**
+ * getHeadInt, getTailInt, getCurrentInt, getNextInt, getPreviousInt
+ *
+ * Move the current pointer as getHead, getTail, getCurrent, getNext and
+ * getPrevious do, then read the integer at the new current node:
+ *
+ *     for (int ok = getHeadInt(list, &v); ok; ok = getNextInt(list, &v)) ...
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param out Where to store the integer
+ * @return 1 if the new current node holds an integer
+ *         0 if the current pointer is NULL or the node holds a pointer
+ */
+int getHeadInt(DLinkedList* dLinkedList, intptr_t* out);
+int getTailInt(DLinkedList* dLinkedList, intptr_t* out);
+int getCurrentInt(DLinkedList* dLinkedList, intptr_t* out);
+int getNextInt(DLinkedList* dLinkedList, intptr_t* out);
+int getPreviousInt(DLinkedList* dLinkedList, intptr_t* out);
+
+/**
+ * removeForwardInt, removeBackwardInt
+ *
+ * Read the integer at the current node, remove the node and move the current
+ * pointer forward or backward.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param out Where to store the integer
+ * @return 1 if an integer was removed
+ *         0 if the current pointer is NULL or the node holds a pointer
+ */
+int removeForwardInt(DLinkedList* dLinkedList, intptr_t* out);
+int removeBackwardInt(DLinkedList* dLinkedList, intptr_t* out);
+
+
+/********************************************
+ * Node-level functions                     *
+ * These link and unlink existing nodes     *
+ * without allocating or freeing anything,  *
+ * except releaseNode and appendList.       *
+ ********************************************/
+
+
+/**
+ * insertNodeHead
+ *
+ * Link an existing, unlinked node in as the head of the doublely linked list.
+ * Do not update the current node. If the list caches keys, the node must be
+ * an LLKeyNode whose key the caller has set. The node must not be one of
+ * another SmallDLinkedList's inline slots; see detachNode.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param node A pointer to the node to link in
+ */
+void insertNodeHead(DLinkedList* dLinkedList, LLNode* node);
+
+
+/**
+ * insertNodeTail
+ *
+ * Link an existing, unlinked node in as the tail of the doublely linked list.
+ * Do not update the current node. If the list caches keys, the node must be
+ * an LLKeyNode whose key the caller has set. The node must not be one of
+ * another SmallDLinkedList's inline slots; see detachNode.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param node A pointer to the node to link in
+ */
+void insertNodeTail(DLinkedList* dLinkedList, LLNode* node);
+
+
+/**
+ * detachNode
+ *
+ * Unlink a node from the doublely linked list without freeing it. If the node is
+ * the current node, the current pointer moves forward to the following node.
+ * The detached node's previous and next pointers are set to NULL.
+ *
+ * A node in a SmallDLinkedList's inline slots must not leave that list: link
+ * it back in or hand it to releaseNode on the same list. Any other list would
+ * give it to free_llnode while it sits inside the source struct, and the
+ * source would never get the slot back. Use appendList to move whole lists,
+ * which copies inline nodes out first.
+ *
+ * @param dLinkedList A pointer to the doublely linked list the node belongs to
+ * @param node A pointer to the node to unlink
+ * @return the detached node
+ */
+LLNode* detachNode(DLinkedList* dLinkedList, LLNode* node);
+
+
+/**
+ * releaseNode
+ *
+ * Give back a node that one of the insert functions made for this list and
+ * detachNode has since unlinked. It goes back to the list's inline slots if it
+ * came from there, and to free_llnode otherwise. The data is not freed.
+ *
+ * @param dLinkedList A pointer to the doublely linked list the node came from
+ * @param node A pointer to the detached node
+ */
+void releaseNode(DLinkedList* dLinkedList, LLNode* node);
+
+
+/**
+ * appendList
+ *
+ * Move every node of the source list onto the tail of the destination list in
+ * O(1) by splicing the chains together. The source list is left empty with a
+ * NULL current pointer. The destination's current pointer does not move. If the
+ * destination is indexed, each moved node is indexed, which is O(n). Nodes in
+ * the source's inline slots cannot leave it, so they are copied first.
+ *
+ * @param dest A pointer to the doublely linked list to append to
+ * @param src A pointer to the doublely linked list to empty
+ * @return 1 if the nodes were moved
+ *         0 if an inline node could not be copied, or the lists have
+ *           different key extractors or only one holds values; both
+ *           lists are unchanged
+ */
+int appendList(DLinkedList* dest, DLinkedList* src);
+
+
+/********************************************
+ * Data index functions                     *
+ * An optional hash index from data         *
+ * pointers to nodes. While it is enabled,  *
+ * every insert and remove keeps it up to   *
+ * date, and data pointers must be unique.  *
+ ********************************************/
+
+
+/**
+ * enableIndex
+ *
+ * Build a data index for the doublely linked list from the nodes it already holds.
+ * Calling this on a list that is already indexed does nothing.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @return 1 if the index is enabled
+ *         0 if the index could not be allocated
+ */
+int enableIndex(DLinkedList* dLinkedList);
+
+
+/**
+ * disableIndex
+ *
+ * Free the data index of the doublely linked list, if it has one.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ */
+void disableIndex(DLinkedList* dLinkedList);
+
+
+/**
+ * findByData
+ *
+ * Find the node holding the data pointer. This is O(1) when the list is indexed
+ * and falls back to a linear scan otherwise. Do not update the current node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param data The data pointer to look for
+ * @return the node holding the data, or NULL if the data is not in the list
+ */
+LLNode* findByData(DLinkedList* dLinkedList, void* data);
+
+
+/**
+ * removeByData
+ *
+ * Remove the node holding the data pointer from the list and return the data.
+ * If that node is the current node, the current pointer moves forward.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param data The data pointer to remove
+ * @return the removed data, or NULL if the data is not in the list
+ */
+void* removeByData(DLinkedList* dLinkedList, void* data);
+
+
+/**
+ * moveToFront
+ *
+ * Relink the node holding the data pointer as the head of the list.
+ * Do not update the current node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param data The data pointer to move
+ * @return 1 if the data was moved
+ *         0 if the data is not in the list
+ */
+int moveToFront(DLinkedList* dLinkedList, void* data);
+
+
+/********************************************
+ * Key cache functions                      *
+ * An optional key cached in each node next *
+ * to its links, taken from the data by the *
+ * list's key extractor at insert time.     *
+ * findByKey and sortByKey compare cached   *
+ * keys, so they only read the data of the  *
+ * nodes they return. A key is not updated  *
+ * if the data changes afterward; remove    *
+ * and reinsert the data to rekey it.       *
+ ********************************************/
+
+
+/**
+ * enableKeys
+ *
+ * Set the doublely linked list's key extractor. Nodes made from then on are
+ * LLKeyNodes, which are malloc'd rather than taken from the node cache or a
+ * SmallDLinkedList's slots. Pass NULL to stop caching keys.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param keyOf The key extractor, or NULL
+ * @return 1 if the extractor is set
+ *         0 if the list is not empty and has a different extractor
+ */
+int enableKeys(DLinkedList* dLinkedList, DLLKeyFn keyOf);
+
+
+/**
+ * findByKey
+ *
+ * Find the first node whose cached key matches, scanning from the head.
+ * Do not update the current node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @param key The key to look for
+ * @return the node, or NULL if no node has the key or the list caches no keys
+ */
+LLNode* findByKey(DLinkedList* dLinkedList, uint64_t key);
+
+
+/**
+ * sortByKey
+ *
+ * Sort the doublely linked list by cached key, smallest first, with a stable
+ * merge sort that relinks the nodes in O(n log n) and allocates nothing. The
+ * current pointer stays on the same node.
+ *
+ * @param dLinkedList A pointer to the doublely linked list
+ * @return 1 if the list was sorted
+ *         0 if the list caches no keys
+ */
+int sortByKey(DLinkedList* dLinkedList);
 #endif
 
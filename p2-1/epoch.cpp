@@ -0,0 +1,178 @@
+// Epoch-based reclamation for nodes unlinked from lock-free lists
+
+#include <stdlib.h>
+#include <string.h>
+#include "epoch.h"
+
+// Reclaim a chain of retired nodes linked through previous
+static void reclaim_chain(EpochDomain* domain, LLNode* node) {
+	while (node != NULL) {
+		LLNode* next = node->previous;
+		if (domain->reclaim != NULL) domain->reclaim(node);
+		else free_llnode(node);
+		node = next;
+	}
+}
+
+// Move the global epoch forward one if every thread inside a critical section
+// has already seen the current epoch
+static void try_advance(EpochDomain* domain) {
+	// Pairs with the fence in epochEnter so an announcement is either seen
+	// here or the entering thread sees the current epoch
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	unsigned long epoch = __atomic_load_n(&domain->epoch, __ATOMIC_ACQUIRE);
+	for (int i = 0; i < EPOCH_MAX_THREADS; i++) {
+		EpochThread* thread = &domain->threads[i];
+		if (!__atomic_load_n(&thread->inUse, __ATOMIC_ACQUIRE)) continue;
+		unsigned long state = __atomic_load_n(&thread->state, __ATOMIC_ACQUIRE);
+		if ((state & 1) && (state >> 1) != epoch) return;
+	}
+	__atomic_compare_exchange_n(&domain->epoch, &epoch, epoch + 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+// Push a chain linked through previous onto the domain's orphans
+static void push_orphans(EpochDomain* domain, LLNode* chain) {
+	LLNode* last = chain;
+	while (last->previous != NULL) last = last->previous;
+	LLNode* top = __atomic_load_n(&domain->orphans, __ATOMIC_RELAXED);
+	do {
+		last->previous = top;
+	} while (!__atomic_compare_exchange_n(&domain->orphans, &top, chain, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+// Reclaim the orphans once the epoch is two past the newest of them. The
+// stack is taken whole, and goes back if a younger chain came with it.
+static void collect_orphans(EpochDomain* domain, unsigned long epoch) {
+	if (__atomic_load_n(&domain->orphans, __ATOMIC_RELAXED) == NULL) return;
+	if (__atomic_load_n(&domain->orphanEpoch, __ATOMIC_RELAXED) + 2 > epoch) return;
+	LLNode* chain = __atomic_exchange_n(&domain->orphans, (LLNode *) NULL, __ATOMIC_ACQUIRE);
+	if (chain == NULL) return;
+
+	// Every chain taken raised orphanEpoch before it was pushed, so this read
+	// covers all of them
+	if (__atomic_load_n(&domain->orphanEpoch, __ATOMIC_RELAXED) + 2 <= epoch) reclaim_chain(domain, chain);
+	else push_orphans(domain, chain);
+}
+
+// Reclaim every limbo chain that is at least two epochs old, and the orphans
+// once they are too
+static void collect(EpochThread* thread) {
+	unsigned long epoch = __atomic_load_n(&thread->domain->epoch, __ATOMIC_ACQUIRE);
+	for (int b = 0; b < 3; b++) {
+		if (thread->limbo[b] != NULL && thread->limboEpoch[b] + 2 <= epoch) {
+			reclaim_chain(thread->domain, thread->limbo[b]);
+			thread->limbo[b] = NULL;
+		}
+	}
+	collect_orphans(thread->domain, epoch);
+}
+
+EpochDomain* create_epochdomain(void (*reclaim)(LLNode* node)) {
+	// Create space for the domain, aligned so each thread record has its own line
+	EpochDomain* domain = (EpochDomain *) aligned_alloc(EPOCH_CACHE_LINE, sizeof(EpochDomain));
+	if (domain == NULL) return NULL;
+
+	memset(domain, 0, sizeof(EpochDomain));
+	domain->reclaim = reclaim;
+	for (int i = 0; i < EPOCH_MAX_THREADS; i++)
+		domain->threads[i].domain = domain;
+	return domain;
+}
+
+void destroyEpochDomain(EpochDomain* domain) {
+	// Nothing can be reading any more, so every retired node can go
+	for (int i = 0; i < EPOCH_MAX_THREADS; i++)
+		for (int b = 0; b < 3; b++)
+			reclaim_chain(domain, domain->threads[i].limbo[b]);
+	reclaim_chain(domain, domain->orphans);
+
+	// Free up the domain's memory
+	free(domain);
+}
+
+EpochThread* epochRegister(EpochDomain* domain) {
+	for (int i = 0; i < EPOCH_MAX_THREADS; i++) {
+		EpochThread* thread = &domain->threads[i];
+		int expected = 0;
+		if (__atomic_load_n(&thread->inUse, __ATOMIC_RELAXED) == 0 &&
+				__atomic_compare_exchange_n(&thread->inUse, &expected, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+			__atomic_store_n(&thread->state, 0UL, __ATOMIC_RELEASE);
+			thread->sinceAdvance = 0;
+			return thread;
+		}
+	}
+	return NULL;
+}
+
+void epochUnregister(EpochThread* thread) {
+	EpochDomain* domain = thread->domain;
+
+	// Give the epoch a chance to reclaim what is left
+	epochSynchronize(thread);
+
+	// Raise orphanEpoch to the newest chain left before pushing any of them,
+	// so whoever takes them sees how young they are
+	unsigned long newest = 0;
+	for (int b = 0; b < 3; b++)
+		if (thread->limbo[b] != NULL && thread->limboEpoch[b] > newest) newest = thread->limboEpoch[b];
+	unsigned long seen = __atomic_load_n(&domain->orphanEpoch, __ATOMIC_RELAXED);
+	while (seen < newest && !__atomic_compare_exchange_n(&domain->orphanEpoch, &seen, newest, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	// Orphan the rest
+	for (int b = 0; b < 3; b++) {
+		if (thread->limbo[b] == NULL) continue;
+		push_orphans(domain, thread->limbo[b]);
+		thread->limbo[b] = NULL;
+	}
+
+	// Hand the record back
+	__atomic_store_n(&thread->state, 0UL, __ATOMIC_RELEASE);
+	__atomic_store_n(&thread->inUse, 0, __ATOMIC_RELEASE);
+}
+
+void epochEnter(EpochThread* thread) {
+	// Announce the epoch, then make sure the announcement is visible before any
+	// shared node is read
+	unsigned long epoch = __atomic_load_n(&thread->domain->epoch, __ATOMIC_RELAXED);
+	__atomic_store_n(&thread->state, (epoch << 1) | 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+void epochExit(EpochThread* thread) {
+	__atomic_store_n(&thread->state, 0UL, __ATOMIC_RELEASE);
+}
+
+void epochRetire(EpochThread* thread, LLNode* node) {
+	unsigned long epoch = __atomic_load_n(&thread->domain->epoch, __ATOMIC_ACQUIRE);
+	int b = epoch % 3;
+
+	// A chain tagged with an older epoch in this slot is at least three epochs
+	// behind, so nobody can still see it
+	if (thread->limboEpoch[b] != epoch) {
+		reclaim_chain(thread->domain, thread->limbo[b]);
+		thread->limbo[b] = NULL;
+		thread->limboEpoch[b] = epoch;
+	}
+	node->previous = thread->limbo[b];
+	thread->limbo[b] = node;
+
+	// Every so often, push the epoch along and reclaim what has aged out
+	if (++thread->sinceAdvance >= EPOCH_ADVANCE_INTERVAL) {
+		thread->sinceAdvance = 0;
+		try_advance(thread->domain);
+		collect(thread);
+	}
+}
+
+int epochSynchronize(EpochThread* thread) {
+	// Two advances past the newest chain are enough when nobody is in the way
+	for (int attempt = 0; attempt < 3; attempt++) {
+		collect(thread);
+		if (thread->limbo[0] == NULL && thread->limbo[1] == NULL && thread->limbo[2] == NULL &&
+				__atomic_load_n(&thread->domain->orphans, __ATOMIC_RELAXED) == NULL)
+			return 1;
+		try_advance(thread->domain);
+	}
+	collect(thread);
+	return thread->limbo[0] == NULL && thread->limbo[1] == NULL && thread->limbo[2] == NULL;
+}
@@ -0,0 +1,162 @@
+/** @file epoch.h */
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <stddef.h>
+#include "doublely_linked_list.h"
+
+/** The most threads that can be registered with one domain at once */
+#define EPOCH_MAX_THREADS 64
+
+/** The cache line size per-thread records are aligned to */
+#define EPOCH_CACHE_LINE 64
+
+/** Retirements between attempts to advance the global epoch */
+#define EPOCH_ADVANCE_INTERVAL 32
+
+
+/********************************************
+ * Epoch-based reclamation functions        *
+ * Defers freeing unlinked list nodes until *
+ * no thread can still be reading them.     *
+ * Readers only announce themselves with a  *
+ * store; they never do an atomic read-     *
+ * modify-write.                            *
+ ********************************************/
+
+
+/**
+ * This structure represents one registered thread. Retired nodes wait in one
+ * of three limbo chains, linked through their previous pointers, according to
+ * the epoch they were retired in.
+ */
+typedef struct epochthread_t {
+    /** The epoch this thread entered in, shifted left one, with bit 0 set
+        while it is inside a critical section. 0 when it is outside. */
+    unsigned long state;
+
+    /** 1 while this record is registered to a thread */
+    int inUse;
+
+    /** Retirements since the last attempt to advance */
+    int sinceAdvance;
+
+    /** Nodes retired in each of the last three epochs */
+    LLNode* limbo[3];
+
+    /** The epoch each limbo chain was filled in */
+    unsigned long limboEpoch[3];
+
+    /** The domain this record belongs to */
+    struct epochdomain_t* domain;
+} __attribute__((aligned(EPOCH_CACHE_LINE))) EpochThread;
+
+/**
+ * This structure represents a reclamation domain: the set of threads that
+ * may be reading the same nodes.
+ */
+typedef struct epochdomain_t {
+    /** The global epoch. Only ever increases. */
+    unsigned long epoch;
+
+    /** Called to free each node once it is safe. free_llnode if NULL. */
+    void (*reclaim)(LLNode* node);
+
+    /** Nodes left behind by unregistered threads, reclaimed once the epoch
+        is two past orphanEpoch, or on destroy */
+    LLNode* orphans;
+
+    /** The newest epoch any orphaned chain was filled in */
+    unsigned long orphanEpoch;
+
+    /** The per-thread records */
+    EpochThread threads[EPOCH_MAX_THREADS];
+} EpochDomain;
+
+
+/**
+ * create_epochdomain
+ *
+ * Creates a reclamation domain by allocating memory for it on the heap.
+ *
+ * @param reclaim Frees a node once no reader can reach it, or NULL for free_llnode
+ * @return A pointer to the domain, or NULL if allocation failed
+ */
+EpochDomain* create_epochdomain(void (*reclaim)(LLNode* node));
+
+/**
+ * destroyEpochDomain
+ *
+ * Reclaim every retired node and free the domain. No thread may be inside a
+ * critical section.
+ *
+ * @param domain A pointer to the domain
+ */
+void destroyEpochDomain(EpochDomain* domain);
+
+/**
+ * epochRegister
+ *
+ * Claim a per-thread record for the calling thread.
+ *
+ * @param domain A pointer to the domain
+ * @return the thread's record, or NULL if EPOCH_MAX_THREADS are already registered
+ */
+EpochThread* epochRegister(EpochDomain* domain);
+
+/**
+ * epochUnregister
+ *
+ * Release the calling thread's record. Retired nodes that cannot be reclaimed
+ * yet are left to the domain; the other threads' epochRetire and
+ * epochSynchronize calls reclaim them once the epoch is two past the newest of
+ * them, and destroyEpochDomain reclaims whatever is left.
+ *
+ * @param thread The thread's record
+ */
+void epochUnregister(EpochThread* thread);
+
+/**
+ * epochEnter
+ *
+ * Begin a critical section. Nodes reachable during the section will not be
+ * reclaimed until the thread calls epochExit.
+ *
+ * @param thread The thread's record
+ */
+void epochEnter(EpochThread* thread);
+
+/**
+ * epochExit
+ *
+ * End a critical section.
+ *
+ * @param thread The thread's record
+ */
+void epochExit(EpochThread* thread);
+
+/**
+ * epochRetire
+ *
+ * Hand over a node that has been unlinked. It is reclaimed once every thread
+ * that might still hold a pointer to it has left its critical section. The
+ * node's previous pointer is used to chain it, so readers must not follow it.
+ *
+ * @param thread The thread's record
+ * @param node The unlinked node
+ */
+void epochRetire(EpochThread* thread, LLNode* node);
+
+/**
+ * epochSynchronize
+ *
+ * Try to advance the epoch far enough to reclaim everything this thread has
+ * retired, and the nodes unregistered threads left behind. Must be called
+ * outside a critical section.
+ *
+ * @param thread The thread's record
+ * @return 1 if everything this thread retired has been reclaimed
+ *         0 if another thread's critical section is holding the epoch back
+ */
+int epochSynchronize(EpochThread* thread);
+#endif
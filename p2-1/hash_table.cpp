@@ -0,0 +1,213 @@
+// A chained hash table with doublely-linked list buckets and incremental rehashing
+
+#include <stdlib.h>
+#include "hash_table.h"
+#include "node_index.h"
+
+// The smallest bucket array the table will allocate
+#define HT_MIN_CAPACITY 8
+
+// The number of non-empty buckets moved per operation during a resize
+#define HT_REHASH_STEP 4
+
+// The number of empty buckets one operation may skip during a resize
+#define HT_EMPTY_VISITS (HT_REHASH_STEP * 10)
+
+// Find the bucket a key belongs in right now
+static DLinkedList* bucket_for(HashTable* table, uint64_t hash) {
+	size_t i = (size_t) hash & (table->capacity[0] - 1);
+	if (table->buckets[1] != NULL && i < table->rehashIndex)
+		return &table->buckets[1][(size_t) hash & (table->capacity[1] - 1)];
+	return &table->buckets[0][i];
+}
+
+// Walk a bucket looking for the entry with the given key. Only entries whose
+// cached hash matches are read past their links.
+static HTEntry* find_entry(DLinkedList* bucket, uint64_t hash, uintptr_t key) {
+	for (LLNode* node = bucket->head; node != NULL; node = node->next) {
+		if (((LLKeyNode *) node)->key != hash) continue;
+		HTEntry* entry = (HTEntry *) node->data;
+		if (entry->key == key) return entry;
+	}
+	return NULL;
+}
+
+// Move a few buckets of the old array into the new one, relinking their nodes
+static void rehash_step(HashTable* table) {
+	// Nothing to do unless a resize is in progress
+	if (table->buckets[1] == NULL) return;
+
+	size_t moved = 0, visits = 0;
+	while (moved < HT_REHASH_STEP && table->rehashIndex < table->capacity[0]) {
+		DLinkedList* bucket = &table->buckets[0][table->rehashIndex++];
+		if (bucket->head == NULL) {
+			if (++visits >= HT_EMPTY_VISITS) break;
+			continue;
+		}
+		while (bucket->head != NULL) {
+			LLNode* node = detachNode(bucket, bucket->head);
+			size_t i = (size_t) ((LLKeyNode *) node)->key & (table->capacity[1] - 1);
+			insertNodeTail(&table->buckets[1][i], node);
+		}
+		moved++;
+	}
+
+	// Once every bucket has moved, the new array takes over
+	if (table->rehashIndex == table->capacity[0]) {
+		free(table->buckets[0]);
+		table->buckets[0] = table->buckets[1];
+		table->capacity[0] = table->capacity[1];
+		table->buckets[1] = NULL;
+		table->capacity[1] = 0;
+		table->rehashIndex = 0;
+	}
+}
+
+// Start a resize if the load factor has left its bounds
+static void maybe_resize(HashTable* table) {
+	// Only one resize runs at a time
+	if (table->buckets[1] != NULL) return;
+
+	// Grow past one entry per bucket, shrink below one per eight
+	size_t capacity = table->capacity[0];
+	if (table->size > capacity) capacity *= 2;
+	else if (capacity > HT_MIN_CAPACITY && table->size * 8 < capacity) {
+		capacity = HT_MIN_CAPACITY;
+		while (capacity < table->size * 2) capacity *= 2;
+	}
+	if (capacity == table->capacity[0]) return;
+
+	// An all-zero DLinkedList is an empty list, so calloc gives empty buckets.
+	// If the allocation fails we carry on with the current array.
+	DLinkedList* buckets = (DLinkedList *) calloc(capacity, sizeof(DLinkedList));
+	if (buckets == NULL) return;
+	table->buckets[1] = buckets;
+	table->capacity[1] = capacity;
+	table->rehashIndex = 0;
+}
+
+HashTable* create_hashtable(void) {
+	// Create space for the table and its first bucket array
+	HashTable* table = (HashTable *) malloc(sizeof(HashTable));
+	if (table == NULL) return NULL;
+	table->buckets[0] = (DLinkedList *) calloc(HT_MIN_CAPACITY, sizeof(DLinkedList));
+	if (table->buckets[0] == NULL) {
+		free(table);
+		return NULL;
+	}
+
+	// Initialize the remaining fields
+	table->buckets[1] = NULL;
+	table->capacity[0] = HT_MIN_CAPACITY;
+	table->capacity[1] = 0;
+	table->rehashIndex = 0;
+	table->size = 0;
+	return table;
+}
+
+void destroyHashTable(HashTable* table) {
+	// Free every entry in both bucket arrays
+	for (int t = 0; t < 2; t++) {
+		if (table->buckets[t] == NULL) continue;
+		for (size_t i = 0; i < table->capacity[t]; i++) {
+			LLNode* node = table->buckets[t][i].head;
+			while (node != NULL) {
+				LLNode* next = node->next;
+				free(node->data);
+				node = next;
+			}
+		}
+		free(table->buckets[t]);
+	}
+
+	// Free up the table's memory
+	free(table);
+}
+
+int htInsert(HashTable* table, uintptr_t key, void* value) {
+	rehash_step(table);
+
+	// Replace the value in place if the key is already present
+	uint64_t hash = hashKey(key);
+	DLinkedList* bucket = bucket_for(table, hash);
+	HTEntry* entry = find_entry(bucket, hash, key);
+	if (entry != NULL) {
+		entry->value = value;
+		return 1;
+	}
+
+	// Create the entry and link it into its bucket
+	entry = (HTEntry *) malloc(sizeof(HTEntry));
+	if (entry == NULL) return 0;
+	entry->node.node.data = entry;
+	entry->node.key = hash;
+	entry->key = key;
+	entry->value = value;
+	insertNodeHead(bucket, &entry->node.node);
+	table->size++;
+	maybe_resize(table);
+	return 1;
+}
+
+void* htLookup(HashTable* table, uintptr_t key) {
+	rehash_step(table);
+
+	// Only return the value if the key is present
+	uint64_t hash = hashKey(key);
+	HTEntry* entry = find_entry(bucket_for(table, hash), hash, key);
+	if (entry != NULL) return entry->value;
+
+	// Return NULL otherwise
+	return NULL;
+}
+
+void* htRemove(HashTable* table, uintptr_t key) {
+	rehash_step(table);
+
+	// Only remove the entry if the key is present
+	uint64_t hash = hashKey(key);
+	DLinkedList* bucket = bucket_for(table, hash);
+	HTEntry* entry = find_entry(bucket, hash, key);
+	if (entry == NULL) return NULL;
+
+	// Unlink and free the entry
+	void* value = entry->value;
+	detachNode(bucket, &entry->node.node);
+	free(entry);
+	table->size--;
+	maybe_resize(table);
+	return value;
+}
+
+size_t htSize(HashTable* table) {
+	return table->size;
+}
+
+double htLoadFactor(HashTable* table) {
+	return (double) table->size / (table->capacity[0] + table->capacity[1]);
+}
+
+void htStats(HashTable* table, HTStats* stats) {
+	// Start from an empty snapshot
+	size_t slots = sizeof(stats->chainHistogram) / sizeof(stats->chainHistogram[0]);
+	stats->loadFactor = htLoadFactor(table);
+	stats->buckets = table->capacity[0] + table->capacity[1];
+	stats->usedBuckets = 0;
+	stats->maxChain = 0;
+	stats->meanChain = 0;
+	for (size_t i = 0; i < slots; i++) stats->chainHistogram[i] = 0;
+	stats->rehashing = table->buckets[1] != NULL;
+
+	// Tally every chain in both bucket arrays
+	for (int t = 0; t < 2; t++) {
+		if (table->buckets[t] == NULL) continue;
+		for (size_t i = 0; i < table->capacity[t]; i++) {
+			size_t length = (size_t) getSize(&table->buckets[t][i]);
+			stats->chainHistogram[length < slots ? length : slots - 1]++;
+			if (length == 0) continue;
+			stats->usedBuckets++;
+			if (length > stats->maxChain) stats->maxChain = length;
+		}
+	}
+	if (stats->usedBuckets != 0) stats->meanChain = (double) table->size / stats->usedBuckets;
+}
@@ -0,0 +1,166 @@
+/** @file hash_table.h */
+#ifndef HASHTABLE_H
+#define HASHTABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "doublely_linked_list.h"
+
+
+/********************************************
+ * Hash table library functions             *
+ * A chained hash table whose buckets are   *
+ * doublely linked lists. Resizing moves a  *
+ * few buckets per operation instead of     *
+ * rebuilding the whole table at once.      *
+ ********************************************/
+
+
+/**
+ * This structure represents a single table entry. The bucket node is embedded
+ * so that an entry costs one allocation, and its data pointer points back at
+ * the entry itself. The node caches the key's hash, so a lookup passes over
+ * other entries in the bucket and rehashing moves entries without rehashing
+ * their keys.
+ */
+typedef struct htentry_t {
+    /** The node linking this entry into its bucket, keyed by hashKey(key). Must be first. */
+    LLKeyNode node;
+
+    /** The key of this entry */
+    uintptr_t key;
+
+    /** The value stored under the key */
+    void* value;
+} HTEntry;
+
+/**
+ * This structure represents an entire hash table. While a resize is in
+ * progress, entries live in both bucket arrays: buckets of the old array
+ * below rehashIndex have already been moved to the new one.
+ */
+typedef struct hashtable_t {
+    /** The bucket arrays. buckets[1] is NULL unless a resize is in progress. */
+    DLinkedList* buckets[2];
+
+    /** The number of buckets in each array. Always a power of two. */
+    size_t capacity[2];
+
+    /** The next bucket of buckets[0] to move during a resize */
+    size_t rehashIndex;
+
+    /** The number of entries in the table */
+    size_t size;
+} HashTable;
+
+/**
+ * This structure holds a snapshot of hash table statistics.
+ */
+typedef struct htstats_t {
+    /** Entries per bucket, over both arrays while resizing */
+    double loadFactor;
+
+    /** The number of buckets, over both arrays while resizing */
+    size_t buckets;
+
+    /** The number of buckets holding at least one entry */
+    size_t usedBuckets;
+
+    /** The length of the longest chain */
+    size_t maxChain;
+
+    /** The mean length of the non-empty chains */
+    double meanChain;
+
+    /** chainHistogram[i] counts chains of length i; the last counts all longer ones */
+    size_t chainHistogram[8];
+
+    /** 1 if a resize is in progress */
+    int rehashing;
+} HTStats;
+
+
+/**
+ * create_hashtable
+ *
+ * Creates an empty hash table by allocating memory for it on the heap.
+ *
+ * @return A pointer to an empty hash table, or NULL if allocation failed
+ */
+HashTable* create_hashtable(void);
+
+/**
+ * destroyHashTable
+ *
+ * Destroy the hash table and all of its entries. The values are not freed.
+ *
+ * @param table A pointer to the hash table
+ */
+void destroyHashTable(HashTable* table);
+
+/**
+ * htInsert
+ *
+ * Store a value under a key, replacing any value already stored there.
+ *
+ * @param table A pointer to the hash table
+ * @param key The key to store the value under
+ * @param value The value to store
+ * @return 1 if the value was stored
+ *         0 if memory ran out
+ */
+int htInsert(HashTable* table, uintptr_t key, void* value);
+
+/**
+ * htLookup
+ *
+ * Look up the value stored under a key.
+ *
+ * @param table A pointer to the hash table
+ * @param key The key to look up
+ * @return the value, or NULL if the key is not in the table
+ */
+void* htLookup(HashTable* table, uintptr_t key);
+
+/**
+ * htRemove
+ *
+ * Remove a key and return the value stored under it.
+ *
+ * @param table A pointer to the hash table
+ * @param key The key to remove
+ * @return the removed value, or NULL if the key is not in the table
+ */
+void* htRemove(HashTable* table, uintptr_t key);
+
+/**
+ * htSize
+ *
+ * Return the number of entries in the hash table
+ *
+ * @param table A pointer to the hash table
+ * @return the number of entries
+ */
+size_t htSize(HashTable* table);
+
+/**
+ * htLoadFactor
+ *
+ * Return the number of entries per bucket. This is O(1); see htStats for
+ * chain-length statistics.
+ *
+ * @param table A pointer to the hash table
+ * @return the load factor
+ */
+double htLoadFactor(HashTable* table);
+
+/**
+ * htStats
+ *
+ * Walk every bucket and fill in load-factor and chain-length statistics.
+ *
+ * @param table A pointer to the hash table
+ * @param stats A pointer to the statistics to fill in
+ */
+void htStats(HashTable* table, HTStats* stats);
+#endif
@@ -0,0 +1,95 @@
+#include "hash_table.h"
+#include "gtest/gtest.h"
+
+
+TEST(HashTable, CreateDestroy)
+{
+	HashTable* table = create_hashtable();
+	ASSERT_TRUE(table != NULL);
+	EXPECT_EQ(0u, htSize(table));
+	EXPECT_EQ(NULL, htLookup(table, 1));
+	destroyHashTable(table);
+}
+
+TEST(HashTable, InsertLookupRemove)
+{
+	int values[3];
+	HashTable* table = create_hashtable();
+
+	// Insert three keys, replacing the value of the last one
+	ASSERT_EQ(1, htInsert(table, 10, &values[0]));
+	ASSERT_EQ(1, htInsert(table, 20, &values[1]));
+	ASSERT_EQ(1, htInsert(table, 30, &values[1]));
+	ASSERT_EQ(1, htInsert(table, 30, &values[2]));
+	EXPECT_EQ(3u, htSize(table));
+
+	// Check the lookups
+	EXPECT_EQ(&values[0], htLookup(table, 10));
+	EXPECT_EQ(&values[1], htLookup(table, 20));
+	EXPECT_EQ(&values[2], htLookup(table, 30));
+	EXPECT_EQ(NULL, htLookup(table, 40));
+
+	// Remove one key
+	EXPECT_EQ(&values[1], htRemove(table, 20));
+	EXPECT_EQ(NULL, htRemove(table, 20));
+	EXPECT_EQ(NULL, htLookup(table, 20));
+	EXPECT_EQ(2u, htSize(table));
+
+	destroyHashTable(table);
+}
+
+TEST(HashTable, IncrementalGrowAndShrink)
+{
+	size_t num_keys = 5000;
+	HashTable* table = create_hashtable();
+
+	// Growing should start a resize that finishes over later operations
+	int saw_rehash = 0;
+	for (size_t i = 0; i < num_keys; i++) {
+		ASSERT_EQ(1, htInsert(table, i, (void*) (i + 1)));
+		if (table->buckets[1] != NULL) saw_rehash = 1;
+	}
+	EXPECT_EQ(1, saw_rehash);
+	EXPECT_EQ(num_keys, htSize(table));
+
+	// Every key must stay reachable, whichever array holds it
+	for (size_t i = 0; i < num_keys; i++)
+		ASSERT_EQ((void*) (i + 1), htLookup(table, i));
+	EXPECT_LE(htLoadFactor(table), 1.0);
+
+	// Removing most keys should shrink the table again
+	size_t grown = table->capacity[0];
+	for (size_t i = 0; i < num_keys - 10; i++)
+		ASSERT_EQ((void*) (i + 1), htRemove(table, i));
+	for (size_t i = num_keys - 10; i < num_keys; i++)
+		ASSERT_EQ((void*) (i + 1), htLookup(table, i));
+	EXPECT_LT(table->capacity[0], grown);
+	EXPECT_EQ(10u, htSize(table));
+
+	destroyHashTable(table);
+}
+
+TEST(HashTable, Stats)
+{
+	HashTable* table = create_hashtable();
+	for (uintptr_t i = 0; i < 100; i++)
+		htInsert(table, i, (void*) (i + 1));
+
+	// The chain lengths must account for every entry and bucket
+	HTStats stats;
+	htStats(table, &stats);
+	size_t buckets = 0, entries = 0;
+	for (size_t i = 0; i < 8; i++)
+		buckets += stats.chainHistogram[i];
+	for (size_t i = 0; i < table->capacity[0]; i++)
+		entries += getSize(&table->buckets[0][i]);
+	for (size_t i = 0; i < table->capacity[1]; i++)
+		entries += getSize(&table->buckets[1][i]);
+	EXPECT_EQ(stats.buckets, buckets);
+	EXPECT_EQ(100u, entries);
+	EXPECT_GE(stats.maxChain, 1u);
+	EXPECT_GE(stats.meanChain, 1.0);
+	EXPECT_DOUBLE_EQ(htLoadFactor(table), stats.loadFactor);
+
+	destroyHashTable(table);
+}
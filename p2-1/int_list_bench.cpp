@@ -0,0 +1,69 @@
+// Integer lists held two ways: each int boxed in its own malloc behind the
+// data pointer, and each int tagged into the data slot with insertTailInt.
+// Reports build, walk and destroy speed and the heap bytes per element.
+//
+// Usage: ./int_list_bench [elements]
+//
+// Memory is the growth in glibc's in-use heap bytes (mallinfo2) while the list
+// is built, so it counts chunk headers as well as the nodes and boxes.
+
+#include <malloc.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "doublely_linked_list.h"
+
+static void report(const char* kind, long n, double times[4], size_t bytes)
+{
+	char name[64];
+	snprintf(name, sizeof(name), "%s build", kind);
+	benchReport(name, n, times[1] - times[0]);
+	snprintf(name, sizeof(name), "%s walk", kind);
+	benchReport(name, 4.0 * n, times[2] - times[1]);
+	snprintf(name, sizeof(name), "%s destroy", kind);
+	benchReport(name, n, times[3] - times[2]);
+	printf("%-44s %.1f\n", "  heap bytes per element", (double) bytes / n);
+}
+
+int main(int argc, char** argv)
+{
+	long n = argc > 1 ? atol(argv[1]) : 10000000;
+	intptr_t sums[2] = {0, 0};
+	double times[4];
+
+	// One allocation for the int and one for the node
+	size_t before = mallinfo2().uordblks;
+	times[0] = benchSeconds();
+	DLinkedList* list = create_dlinkedlist();
+	for (long i = 0; i < n; i++) {
+		intptr_t* box = (intptr_t*) malloc(sizeof(intptr_t));
+		*box = i;
+		insertTail(list, box);
+	}
+	times[1] = benchSeconds();
+	size_t bytes = mallinfo2().uordblks - before;
+	for (int pass = 0; pass < 4; pass++)
+		for (void* d = getHead(list); d != NULL; d = getNext(list)) sums[0] += *(intptr_t*) d;
+	times[2] = benchSeconds();
+	destroyList(list);
+	times[3] = benchSeconds();
+	report("boxed ", n, times, bytes);
+
+	// The int lives in the node
+	before = mallinfo2().uordblks;
+	times[0] = benchSeconds();
+	list = create_dlinkedlist();
+	for (long i = 0; i < n; i++) insertTailInt(list, i);
+	times[1] = benchSeconds();
+	bytes = mallinfo2().uordblks - before;
+	intptr_t v;
+	for (int pass = 0; pass < 4; pass++)
+		for (int ok = getHeadInt(list, &v); ok; ok = getNextInt(list, &v)) sums[1] += v;
+	times[2] = benchSeconds();
+	destroyList(list);
+	times[3] = benchSeconds();
+	report("tagged", n, times, bytes);
+
+	// Both sides walked the same ints
+	return sums[0] != sums[1];
+}
@@ -0,0 +1,80 @@
+// Searching a list by a key kept in each element's payload, against the same
+// search over keys cached in the nodes by enableKeys, and sorting by cached key.
+// The payloads are allocated in a shuffled order, so following a node's data
+// pointer misses the cache the way long-lived heap objects do.
+//
+// Usage: ./key_cache_bench [elements] [searches]
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "doublely_linked_list.h"
+
+// A payload the size of a cache line, with its key at the front
+typedef struct item_t {
+	uint64_t key;
+	char rest[56];
+} Item;
+
+static uint64_t item_key(void* data)
+{
+	return ((Item*) data)->key;
+}
+
+// The search a list without cached keys has to do
+static LLNode* find_in_payload(DLinkedList* list, uint64_t key)
+{
+	for (LLNode* node = list->head; node != NULL; node = node->next) {
+		if (((Item*) node->data)->key == key) return node;
+	}
+	return NULL;
+}
+
+int main(int argc, char** argv)
+{
+	long n = argc > 1 ? atol(argv[1]) : 1000000;
+	long searches = argc > 2 ? atol(argv[2]) : 20;
+	uint64_t seed = 1;
+
+	// Allocate the payloads, then shuffle the order they are listed in
+	Item** items = (Item**) malloc(n * sizeof(Item*));
+	for (long i = 0; i < n; i++) {
+		items[i] = (Item*) malloc(sizeof(Item));
+		items[i]->key = (uint64_t) i;
+	}
+	for (long i = n - 1; i > 0; i--) {
+		long j = (long) (benchRandom(&seed) % (uint64_t) (i + 1));
+		Item* swap = items[i];
+		items[i] = items[j];
+		items[j] = swap;
+	}
+
+	DLinkedList* plain = create_dlinkedlist();
+	DLinkedList* keyed = create_dlinkedlist();
+	enableKeys(keyed, item_key);
+	for (long i = 0; i < n; i++) {
+		insertTail(plain, items[i]);
+		insertTail(keyed, items[i]);
+	}
+
+	// Search for keys that are not there, so every search scans every node
+	long misses = 0;
+	double begin = benchSeconds();
+	for (long s = 0; s < searches; s++) misses += find_in_payload(plain, (uint64_t) (n + s)) == NULL;
+	benchReport("find, key in payload (nodes)", (double) searches * n, benchSeconds() - begin);
+
+	begin = benchSeconds();
+	for (long s = 0; s < searches; s++) misses += findByKey(keyed, (uint64_t) (n + s)) == NULL;
+	benchReport("find, key cached in node (nodes)", (double) searches * n, benchSeconds() - begin);
+
+	begin = benchSeconds();
+	sortByKey(keyed);
+	benchReport("sortByKey", n, benchSeconds() - begin);
+
+	// Tear down, freeing each payload once
+	benchDrain(keyed);
+	destroyList(keyed);
+	destroyList(plain);
+	free(items);
+	return misses != 2 * searches;
+}
@@ -0,0 +1,72 @@
+/** @file list_policies.h */
+#ifndef LISTPOLICIES_H
+#define LISTPOLICIES_H
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "node_alloc.h"
+#include "policy_list.h"
+
+
+/********************************************
+ * Heap and thread policies                 *
+ * The PolicyList allocator policies that   *
+ * take nodes from the heap, and the lock   *
+ * policy that needs pthreads. They live    *
+ * apart from the policy core so a list     *
+ * that uses neither, like a                *
+ * StaticDLinkedList, does not pull them    *
+ * in.                                      *
+ ********************************************/
+
+
+/** Nodes from the per-thread magazines, as create_llnode uses */
+struct MagazineNodes {
+    LLNode* allocate() { return nodeAlloc(); }
+    void deallocate(LLNode* node) { nodeFree(node); }
+};
+
+/** Nodes straight from malloc and free */
+struct MallocNodes {
+    LLNode* allocate() { return (LLNode *) malloc(sizeof(LLNode)); }
+    void deallocate(LLNode* node) { free(node); }
+};
+
+/** Nodes recycled through a free chain owned by the list. The list's lock
+    policy guards it, so only the list may use it. */
+struct PoolNodes {
+    /** Freed nodes waiting to be reused, chained through next */
+    LLNode* spare;
+
+    PoolNodes() : spare(NULL) {}
+    ~PoolNodes() {
+        while (spare != NULL) {
+            LLNode* next = spare->next;
+            free(spare);
+            spare = next;
+        }
+    }
+
+    LLNode* allocate() {
+        if (spare == NULL) return (LLNode *) malloc(sizeof(LLNode));
+        LLNode* node = spare;
+        spare = node->next;
+        return node;
+    }
+
+    void deallocate(LLNode* node) {
+        node->next = spare;
+        spare = node;
+    }
+};
+
+/** One mutex around every call */
+struct MutexLock {
+    pthread_mutex_t mutex;
+
+    MutexLock() { pthread_mutex_init(&mutex, NULL); }
+    ~MutexLock() { pthread_mutex_destroy(&mutex); }
+    void lock() { pthread_mutex_lock(&mutex); }
+    void unlock() { pthread_mutex_unlock(&mutex); }
+};
+#endif
@@ -0,0 +1,166 @@
+// A lock-free sorted list of keys in the style of Harris and Michael
+
+#include <stdlib.h>
+#include "lockfree_list.h"
+
+// The low bit of a next pointer marks its node as logically deleted
+#define MARKED(p) (((uintptr_t) (p)) & 1)
+#define MARK(p) ((LLNode*) (((uintptr_t) (p)) | 1))
+#define UNMARK(p) ((LLNode*) (((uintptr_t) (p)) & ~(uintptr_t) 1))
+#define KEY(node) ((uintptr_t) (node)->data)
+
+// Find the first node whose key is at least key, unlinking and retiring any
+// marked nodes on the way. On return *prev is the link that points at *curr.
+// Must be called inside a critical section.
+static int find(LockFreeList* list, EpochThread* thread, uintptr_t key, LLNode*** prev, LLNode** curr) {
+retry:
+	LLNode** link = &list->head.next;
+	LLNode* node = __atomic_load_n(link, __ATOMIC_ACQUIRE);
+	while (node != NULL) {
+		LLNode* next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+
+		// Help finish a removal. Losing the race means the predecessor changed.
+		if (MARKED(next)) {
+			LLNode* expected = node;
+			if (!__atomic_compare_exchange_n(link, &expected, UNMARK(next), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+				goto retry;
+			epochRetire(thread, node);
+			node = UNMARK(next);
+			continue;
+		}
+
+		if (KEY(node) >= key) {
+			*prev = link;
+			*curr = node;
+			return KEY(node) == key;
+		}
+		link = &node->next;
+		node = next;
+	}
+	*prev = link;
+	*curr = NULL;
+	return 0;
+}
+
+LockFreeList* create_lockfreelist(void) {
+	// Create space for the list
+	LockFreeList* list = (LockFreeList *) malloc(sizeof(LockFreeList));
+	if (list == NULL) return NULL;
+
+	// Removed nodes came from create_llnode, so the domain frees them with free_llnode
+	list->domain = create_epochdomain(NULL);
+	if (list->domain == NULL) {
+		free(list);
+		return NULL;
+	}
+	list->head.data = NULL;
+	list->head.previous = NULL;
+	list->head.next = NULL;
+	return list;
+}
+
+void destroyLockFreeList(LockFreeList* list) {
+	// Free every node still linked, marked or not
+	LLNode* node = list->head.next;
+	while (node != NULL) {
+		LLNode* next = UNMARK(node->next);
+		free_llnode(node);
+		node = next;
+	}
+
+	// Free the retired nodes, then the list's memory
+	destroyEpochDomain(list->domain);
+	free(list);
+}
+
+EpochThread* lfRegister(LockFreeList* list) {
+	return epochRegister(list->domain);
+}
+
+void lfUnregister(EpochThread* thread) {
+	epochUnregister(thread);
+}
+
+int lfInsert(LockFreeList* list, EpochThread* thread, uintptr_t key) {
+	LLNode* node = NULL;
+	LLNode** prev;
+	LLNode* curr;
+
+	epochEnter(thread);
+	while (1) {
+		if (find(list, thread, key, &prev, &curr)) {
+			epochExit(thread);
+			free_llnode(node);
+			return 0;
+		}
+
+		// Allocate once, however many times the link has to be retried
+		if (node == NULL) {
+			node = create_llnode((void*) key);
+			if (node == NULL) {
+				epochExit(thread);
+				return 0;
+			}
+		}
+
+		// Publish the node between prev and curr
+		node->next = curr;
+		LLNode* expected = curr;
+		if (__atomic_compare_exchange_n(prev, &expected, node, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+			epochExit(thread);
+			return 1;
+		}
+	}
+}
+
+int lfRemove(LockFreeList* list, EpochThread* thread, uintptr_t key) {
+	LLNode** prev;
+	LLNode* curr;
+
+	epochEnter(thread);
+	while (1) {
+		if (!find(list, thread, key, &prev, &curr)) {
+			epochExit(thread);
+			return 0;
+		}
+
+		// Logically delete by marking; whoever sets the mark owns the removal
+		LLNode* next = __atomic_load_n(&curr->next, __ATOMIC_ACQUIRE);
+		if (MARKED(next)) continue;
+		if (!__atomic_compare_exchange_n(&curr->next, &next, MARK(next), 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+			continue;
+
+		// Try to unlink it now, or leave it for the next traversal to clean up
+		LLNode* expected = curr;
+		if (__atomic_compare_exchange_n(prev, &expected, next, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+			epochRetire(thread, curr);
+		else
+			find(list, thread, key, &prev, &curr);
+		epochExit(thread);
+		return 1;
+	}
+}
+
+int lfContains(LockFreeList* list, EpochThread* thread, uintptr_t key) {
+	epochEnter(thread);
+
+	// Walk past marked nodes without helping, so readers never write
+	LLNode* node = __atomic_load_n(&list->head.next, __ATOMIC_ACQUIRE);
+	while (node != NULL && KEY(node) < key)
+		node = UNMARK(__atomic_load_n(&node->next, __ATOMIC_ACQUIRE));
+	int found = node != NULL && KEY(node) == key && !MARKED(__atomic_load_n(&node->next, __ATOMIC_ACQUIRE));
+
+	epochExit(thread);
+	return found;
+}
+
+size_t lfSize(LockFreeList* list) {
+	size_t size = 0;
+	LLNode* node = __atomic_load_n(&list->head.next, __ATOMIC_ACQUIRE);
+	while (node != NULL) {
+		LLNode* next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+		if (!MARKED(next)) size++;
+		node = UNMARK(next);
+	}
+	return size;
+}
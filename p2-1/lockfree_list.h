@@ -0,0 +1,122 @@
+/** @file lockfree_list.h */
+#ifndef LOCKFREELIST_H
+#define LOCKFREELIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "doublely_linked_list.h"
+#include "epoch.h"
+
+
+/********************************************
+ * Lock-free list library functions         *
+ * A sorted set of keys kept in LLNodes     *
+ * using the Harris-Michael algorithm.      *
+ * Removal first marks the low bit of a     *
+ * node's next pointer, then unlinks it;    *
+ * unlinked nodes are freed through epoch-  *
+ * based reclamation.                       *
+ ********************************************/
+
+
+/**
+ * This structure represents an entire lock-free list. Each node keeps its
+ * key in data and links forward through next, whose low bit marks the node
+ * as deleted. previous is only used to chain retired nodes.
+ */
+typedef struct lockfreelist_t {
+    /** Sentinel before the smallest key. Only its next is used. */
+    LLNode head;
+
+    /** Defers freeing removed nodes until no thread can be reading them */
+    EpochDomain* domain;
+} LockFreeList;
+
+
+/**
+ * create_lockfreelist
+ *
+ * Creates an empty lock-free list by allocating memory for it on the heap.
+ *
+ * @return A pointer to an empty list, or NULL if allocation failed
+ */
+LockFreeList* create_lockfreelist(void);
+
+/**
+ * destroyLockFreeList
+ *
+ * Destroy the list and every node it holds. Every thread must have
+ * unregistered first.
+ *
+ * @param list A pointer to the list
+ */
+void destroyLockFreeList(LockFreeList* list);
+
+/**
+ * lfRegister
+ *
+ * Register the calling thread with the list. Every other operation takes the
+ * returned record.
+ *
+ * @param list A pointer to the list
+ * @return the thread's record, or NULL if EPOCH_MAX_THREADS are already registered
+ */
+EpochThread* lfRegister(LockFreeList* list);
+
+/**
+ * lfUnregister
+ *
+ * Release the calling thread's record.
+ *
+ * @param thread The thread's record
+ */
+void lfUnregister(EpochThread* thread);
+
+/**
+ * lfInsert
+ *
+ * Add a key to the list in sorted position.
+ *
+ * @param list A pointer to the list
+ * @param thread The calling thread's record
+ * @param key The key to add
+ * @return 1 if the key was added
+ *         0 if it was already present or no node could be allocated
+ */
+int lfInsert(LockFreeList* list, EpochThread* thread, uintptr_t key);
+
+/**
+ * lfRemove
+ *
+ * Remove a key from the list.
+ *
+ * @param list A pointer to the list
+ * @param thread The calling thread's record
+ * @param key The key to remove
+ * @return 1 if this call removed the key
+ *         0 if it was not present
+ */
+int lfRemove(LockFreeList* list, EpochThread* thread, uintptr_t key);
+
+/**
+ * lfContains
+ *
+ * Check for a key without writing to the list.
+ *
+ * @param list A pointer to the list
+ * @param thread The calling thread's record
+ * @param key The key to look for
+ * @return 1 if the key is present, 0 otherwise
+ */
+int lfContains(LockFreeList* list, EpochThread* thread, uintptr_t key);
+
+/**
+ * lfSize
+ *
+ * Count the keys in the list. Only exact while no other thread is writing.
+ *
+ * @param list A pointer to the list
+ * @return the number of unmarked nodes in the list
+ */
+size_t lfSize(LockFreeList* list);
+#endif
@@ -0,0 +1,115 @@
+// The lock-free sorted list against one mutex around a sorted DLinkedList,
+// from 1 to 32 threads
+//
+// Usage: ./lockfree_list_bench [operations per thread] [key range]
+//
+// Each operation is a lookup 80% of the time, an insert 10% and a remove 10%,
+// on keys drawn uniformly from the range. Both lists start half full.
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "lockfree_list.h"
+
+struct Workload {
+	LockFreeList* lf;
+	DLinkedList* list;
+	pthread_mutex_t mutex;
+	long ops;
+	uintptr_t keys;
+	int sink;
+};
+
+static void* lockfree_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	uint64_t rng = 0x9e3779b97f4a7c15ULL * (t->index + 1);
+	EpochThread* thread = lfRegister(w->lf);
+	int sink = 0;
+	for (long i = 0; i < w->ops; i++) {
+		uint64_t r = benchRandom(&rng);
+		uintptr_t key = 1 + (r >> 8) % w->keys;
+		int op = r % 100;
+		if (op < 80) sink += lfContains(w->lf, thread, key);
+		else if (op < 90) sink += lfInsert(w->lf, thread, key);
+		else sink += lfRemove(w->lf, thread, key);
+	}
+	lfUnregister(thread);
+	__atomic_fetch_add(&w->sink, sink, __ATOMIC_RELAXED);
+	return NULL;
+}
+
+// Point the list's cursor at the first node whose key is at least key
+static LLNode* seek(DLinkedList* list, uintptr_t key)
+{
+	LLNode* node = list->head;
+	while (node != NULL && (uintptr_t) node->data < key)
+		node = node->next;
+	list->current = node;
+	return node;
+}
+
+static void* mutex_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	uint64_t rng = 0x9e3779b97f4a7c15ULL * (t->index + 1);
+	int sink = 0;
+	for (long i = 0; i < w->ops; i++) {
+		uint64_t r = benchRandom(&rng);
+		uintptr_t key = 1 + (r >> 8) % w->keys;
+		int op = r % 100;
+		pthread_mutex_lock(&w->mutex);
+		LLNode* node = seek(w->list, key);
+		int found = node != NULL && (uintptr_t) node->data == key;
+		if (op < 80) {
+			sink += found;
+		} else if (op < 90) {
+			if (!found && node != NULL) sink += insertBefore(w->list, (void*) key);
+			else if (!found) insertTail(w->list, (void*) key);
+		} else if (found) {
+			removeForward(w->list);
+			sink++;
+		}
+		pthread_mutex_unlock(&w->mutex);
+	}
+	__atomic_fetch_add(&w->sink, sink, __ATOMIC_RELAXED);
+	return NULL;
+}
+
+int main(int argc, char** argv)
+{
+	Workload w;
+	w.ops = argc > 1 ? atol(argv[1]) : 200000;
+	w.keys = argc > 2 ? atol(argv[2]) : 512;
+	w.sink = 0;
+	pthread_mutex_init(&w.mutex, NULL);
+
+	for (int threads = 1; threads <= 32; threads *= 2) {
+		char name[64];
+		w.lf = create_lockfreelist();
+		w.list = create_dlinkedlist();
+
+		// Start with every even key
+		EpochThread* thread = lfRegister(w.lf);
+		for (uintptr_t key = 2; key <= w.keys; key += 2) {
+			lfInsert(w.lf, thread, key);
+			insertTail(w.list, (void*) key);
+		}
+		lfUnregister(thread);
+
+		double seconds = benchRunThreads(threads, lockfree_body, &w);
+		snprintf(name, sizeof(name), "lock-free threads=%2d keys=%lu", threads, (unsigned long) w.keys);
+		benchReport(name, (double) w.ops * threads, seconds);
+
+		seconds = benchRunThreads(threads, mutex_body, &w);
+		snprintf(name, sizeof(name), "mutex     threads=%2d keys=%lu", threads, (unsigned long) w.keys);
+		benchReport(name, (double) w.ops * threads, seconds);
+
+		benchDrain(w.list);
+		destroyLockFreeList(w.lf);
+		destroyList(w.list);
+	}
+
+	pthread_mutex_destroy(&w.mutex);
+	return w.sink == -1;
+}
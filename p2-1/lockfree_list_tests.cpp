@@ -0,0 +1,159 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "lockfree_list.h"
+#include "gtest/gtest.h"
+
+
+#define STRESS_THREADS 4
+#define STRESS_OPERATIONS 50000
+#define STRESS_KEYS 256
+
+struct StressArgs {
+	LockFreeList* list;
+	unsigned seed;
+	long inserted;
+	long removed;
+};
+
+// Randomly inserts, removes and looks up keys from a small range
+static void* stress_thread(void* arg)
+{
+	StressArgs* args = (StressArgs*) arg;
+	EpochThread* thread = lfRegister(args->list);
+	for (int i = 0; i < STRESS_OPERATIONS; i++) {
+		uintptr_t key = 1 + rand_r(&args->seed) % STRESS_KEYS;
+		switch (rand_r(&args->seed) % 3) {
+		case 0: args->inserted += lfInsert(args->list, thread, key); break;
+		case 1: args->removed += lfRemove(args->list, thread, key); break;
+		default: lfContains(args->list, thread, key); break;
+		}
+	}
+	lfUnregister(thread);
+	return NULL;
+}
+
+static int reclaimed;
+static void count_reclaim(LLNode* node)
+{
+	reclaimed++;
+	free_llnode(node);
+}
+
+
+TEST(LockFreeList, InsertRemoveContains)
+{
+	LockFreeList* list = create_lockfreelist();
+	ASSERT_TRUE(list != NULL);
+	EpochThread* thread = lfRegister(list);
+	ASSERT_TRUE(thread != NULL);
+
+	// Keys can be added in any order but only once
+	EXPECT_EQ(1, lfInsert(list, thread, 30));
+	EXPECT_EQ(1, lfInsert(list, thread, 10));
+	EXPECT_EQ(1, lfInsert(list, thread, 20));
+	EXPECT_EQ(0, lfInsert(list, thread, 20));
+	EXPECT_EQ(3u, lfSize(list));
+
+	// The nodes are kept in sorted order
+	LLNode* node = list->head.next;
+	EXPECT_EQ((void*) 10, node->data);
+	EXPECT_EQ((void*) 20, node->next->data);
+	EXPECT_EQ((void*) 30, node->next->next->data);
+
+	EXPECT_EQ(1, lfContains(list, thread, 20));
+	EXPECT_EQ(1, lfRemove(list, thread, 20));
+	EXPECT_EQ(0, lfContains(list, thread, 20));
+	EXPECT_EQ(0, lfRemove(list, thread, 20));
+	EXPECT_EQ(0, lfContains(list, thread, 25));
+	EXPECT_EQ(2u, lfSize(list));
+
+	lfUnregister(thread);
+	destroyLockFreeList(list);
+}
+
+TEST(LockFreeList, RetireWaitsForReaders)
+{
+	reclaimed = 0;
+	EpochDomain* domain = create_epochdomain(count_reclaim);
+	EpochThread* reader = epochRegister(domain);
+	EpochThread* writer = epochRegister(domain);
+
+	// A reader inside its critical section holds the node back
+	epochEnter(reader);
+	epochRetire(writer, create_llnode(NULL));
+	EXPECT_EQ(0, epochSynchronize(writer));
+	EXPECT_EQ(0, reclaimed);
+
+	// Once it leaves, the node can be reclaimed
+	epochExit(reader);
+	EXPECT_EQ(1, epochSynchronize(writer));
+	EXPECT_EQ(1, reclaimed);
+
+	// Nodes still waiting when their thread leaves are freed with the domain
+	epochEnter(reader);
+	epochRetire(writer, create_llnode(NULL));
+	epochUnregister(writer);
+	EXPECT_EQ(1, reclaimed);
+	epochExit(reader);
+	epochUnregister(reader);
+	destroyEpochDomain(domain);
+	EXPECT_EQ(2, reclaimed);
+}
+
+TEST(LockFreeList, OrphansAreReclaimed)
+{
+	reclaimed = 0;
+	EpochDomain* domain = create_epochdomain(count_reclaim);
+	EpochThread* reader = epochRegister(domain);
+
+	// Threads that leave while the reader holds the epoch back orphan their
+	// nodes, and the reader reclaims them once it is out of the way
+	for (int i = 0; i < 100; i++) {
+		EpochThread* writer = epochRegister(domain);
+		epochEnter(reader);
+		epochRetire(writer, create_llnode(NULL));
+		epochUnregister(writer);
+		EXPECT_TRUE(domain->orphans != NULL);
+		epochExit(reader);
+		EXPECT_EQ(1, epochSynchronize(reader));
+		EXPECT_TRUE(domain->orphans == NULL);
+		EXPECT_EQ(i + 1, reclaimed);
+	}
+
+	epochUnregister(reader);
+	destroyEpochDomain(domain);
+	EXPECT_EQ(100, reclaimed);
+}
+
+TEST(LockFreeList, Stress)
+{
+	LockFreeList* list = create_lockfreelist();
+	pthread_t threads[STRESS_THREADS];
+	StressArgs args[STRESS_THREADS];
+	for (int t = 0; t < STRESS_THREADS; t++) {
+		args[t].list = list;
+		args[t].seed = t + 1;
+		args[t].inserted = 0;
+		args[t].removed = 0;
+		pthread_create(&threads[t], NULL, stress_thread, &args[t]);
+	}
+
+	long net = 0;
+	for (int t = 0; t < STRESS_THREADS; t++) {
+		pthread_join(threads[t], NULL);
+		net += args[t].inserted - args[t].removed;
+	}
+
+	// Every successful insert and remove is accounted for, and the survivors
+	// are strictly increasing with no marked nodes left behind
+	EXPECT_EQ((size_t) net, lfSize(list));
+	uintptr_t last = 0;
+	for (LLNode* node = list->head.next; node != NULL; node = node->next) {
+		ASSERT_EQ(0u, (uintptr_t) node->next & 1);
+		ASSERT_LT(last, (uintptr_t) node->data);
+		last = (uintptr_t) node->data;
+	}
+
+	destroyLockFreeList(list);
+}
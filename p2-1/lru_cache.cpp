@@ -0,0 +1,145 @@
+// An LRU cache built on the doublely-linked list and the node index
+
+#include <stdlib.h>
+#include "lru_cache.h"
+
+// Return an entry to the spare chain so the next put can reuse it
+static void release_entry(LRUCache* cache, LRUEntry* entry) {
+	entry->node.next = cache->spare;
+	cache->spare = &entry->node;
+}
+
+// Take an entry from the spare chain, or allocate one if the chain is empty
+static LRUEntry* acquire_entry(LRUCache* cache) {
+	if (cache->spare == NULL) return (LRUEntry *) malloc(sizeof(LRUEntry));
+	LRUEntry* entry = (LRUEntry *) cache->spare->data;
+	cache->spare = cache->spare->next;
+	return entry;
+}
+
+// Unlink the least recently used entry and hand its value to the callback
+static void evict_tail(LRUCache* cache) {
+	LRUEntry* entry = (LRUEntry *) cache->list->tail->data;
+	detachNode(cache->list, &entry->node);
+	nodeIndexRemove(cache->index, entry->key, &entry->node);
+	cache->bytes -= entry->bytes;
+	if (cache->onEvict != NULL) cache->onEvict(entry->key, entry->value, cache->context);
+	release_entry(cache, entry);
+}
+
+// Check whether adding the given entry count and size would exceed a limit
+static int over_limit(LRUCache* cache, size_t entries, size_t bytes) {
+	if (cache->maxEntries != 0 && (size_t) getSize(cache->list) + entries > cache->maxEntries) return 1;
+	if (cache->maxBytes != 0 && cache->bytes + bytes > cache->maxBytes) return 1;
+	return 0;
+}
+
+LRUCache* create_lrucache(size_t maxEntries, size_t maxBytes, LRUEvictFn onEvict, void* context) {
+	// Create space for the cache, its list and its index
+	LRUCache* cache = (LRUCache *) malloc(sizeof(LRUCache));
+	if (cache == NULL) return NULL;
+	cache->list = create_dlinkedlist();
+	cache->index = create_nodeindex();
+	if (cache->list == NULL || cache->index == NULL) {
+		if (cache->list != NULL) destroyList(cache->list);
+		if (cache->index != NULL) destroyNodeIndex(cache->index);
+		free(cache);
+		return NULL;
+	}
+
+	// Initialize the limits and counters
+	cache->spare = NULL;
+	cache->maxEntries = maxEntries;
+	cache->maxBytes = maxBytes;
+	cache->bytes = 0;
+	cache->onEvict = onEvict;
+	cache->context = context;
+	return cache;
+}
+
+void destroyLRUCache(LRUCache* cache) {
+	// Hand every remaining value to the callback and free the entries
+	while (cache->list->tail != NULL) evict_tail(cache);
+	while (cache->spare != NULL) free(acquire_entry(cache));
+
+	// Free up the cache's memory
+	destroyList(cache->list);
+	destroyNodeIndex(cache->index);
+	free(cache);
+}
+
+void* lruGet(LRUCache* cache, uintptr_t key) {
+	// Only touch the entry if the key is cached
+	LLNode* node = nodeIndexGet(cache->index, key);
+	if (node == NULL) return NULL;
+
+	// Relink the entry as the most recently used
+	if (node != cache->list->head) {
+		detachNode(cache->list, node);
+		insertNodeHead(cache->list, node);
+	}
+	return ((LRUEntry *) node->data)->value;
+}
+
+int lruPut(LRUCache* cache, uintptr_t key, void* value, size_t bytes) {
+	// An entry larger than the whole cache can never fit
+	if (cache->maxBytes != 0 && bytes > cache->maxBytes) return 0;
+
+	// Replace the value in place if the key is already cached
+	LLNode* node = nodeIndexGet(cache->index, key);
+	if (node != NULL) {
+		LRUEntry* entry = (LRUEntry *) node->data;
+		if (entry->value != value && cache->onEvict != NULL) cache->onEvict(key, entry->value, cache->context);
+		cache->bytes = cache->bytes - entry->bytes + bytes;
+		entry->value = value;
+		entry->bytes = bytes;
+		if (node != cache->list->head) {
+			detachNode(cache->list, node);
+			insertNodeHead(cache->list, node);
+		}
+
+		// The new size may push older entries out
+		while (over_limit(cache, 0, 0) && cache->list->tail != node) evict_tail(cache);
+		return 1;
+	}
+
+	// Make room first so the evicted entry can be reused for this one
+	while (cache->list->tail != NULL && over_limit(cache, 1, bytes)) evict_tail(cache);
+	LRUEntry* entry = acquire_entry(cache);
+	if (entry == NULL) return 0;
+	entry->node.data = entry;
+	entry->key = key;
+	entry->value = value;
+	entry->bytes = bytes;
+	if (!nodeIndexPut(cache->index, key, &entry->node)) {
+		release_entry(cache, entry);
+		return 0;
+	}
+
+	// Link the entry in as the most recently used
+	insertNodeHead(cache->list, &entry->node);
+	cache->bytes += bytes;
+	return 1;
+}
+
+void* lruRemove(LRUCache* cache, uintptr_t key) {
+	// Only remove the entry if the key is cached
+	LLNode* node = nodeIndexRemove(cache->index, key, NULL);
+	if (node == NULL) return NULL;
+
+	// Unlink the entry and keep it for reuse
+	LRUEntry* entry = (LRUEntry *) node->data;
+	void* value = entry->value;
+	detachNode(cache->list, node);
+	cache->bytes -= entry->bytes;
+	release_entry(cache, entry);
+	return value;
+}
+
+int lruSize(LRUCache* cache) {
+	return getSize(cache->list);
+}
+
+size_t lruBytes(LRUCache* cache) {
+	return cache->bytes;
+}
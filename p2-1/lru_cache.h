@@ -0,0 +1,159 @@
+/** @file lru_cache.h */
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "doublely_linked_list.h"
+#include "node_index.h"
+
+
+/********************************************
+ * LRU cache library functions              *
+ * A least-recently-used cache built from a *
+ * doublely linked list ordered by recency  *
+ * and a node index keyed by cache key.     *
+ ********************************************/
+
+
+/**
+ * Callback invoked for every value that leaves the cache other than through
+ * lruRemove: evictions, replacements by lruPut, and destroyLRUCache.
+ *
+ * @param key The key of the entry leaving the cache
+ * @param value The value of the entry leaving the cache
+ * @param context The context pointer given to create_lrucache
+ */
+typedef void (*LRUEvictFn)(uintptr_t key, void* value, void* context);
+
+/**
+ * This structure represents a single cache entry. The list node is embedded
+ * so that an entry costs one allocation, and its data pointer points back at
+ * the entry itself.
+ */
+typedef struct lruentry_t {
+    /** The node linking this entry into the recency list. Must be first. */
+    LLNode node;
+
+    /** The key of this entry */
+    uintptr_t key;
+
+    /** The cached value */
+    void* value;
+
+    /** The size the caller charged for this entry */
+    size_t bytes;
+} LRUEntry;
+
+/**
+ * This structure represents an entire LRU cache.
+ */
+typedef struct lrucache_t {
+    /** Entries ordered from most (head) to least (tail) recently used */
+    DLinkedList* list;
+
+    /** Index from keys to the nodes of their entries */
+    NodeIndex* index;
+
+    /** Entries kept for reuse, chained through their next pointers */
+    LLNode* spare;
+
+    /** The maximum number of entries. 0 means no limit. */
+    size_t maxEntries;
+
+    /** The maximum sum of entry sizes. 0 means no limit. */
+    size_t maxBytes;
+
+    /** The current sum of entry sizes */
+    size_t bytes;
+
+    /** Called for each value leaving the cache. May be NULL. */
+    LRUEvictFn onEvict;
+
+    /** Passed through to onEvict */
+    void* context;
+} LRUCache;
+
+
+/**
+ * create_lrucache
+ *
+ * Creates an empty LRU cache by allocating memory for it on the heap. The cache
+ * can be bounded by entry count, by the sum of entry sizes, or both.
+ *
+ * @param maxEntries The maximum number of entries, or 0 for no limit
+ * @param maxBytes The maximum sum of entry sizes, or 0 for no limit
+ * @param onEvict Callback for values leaving the cache, or NULL
+ * @param context Passed through to onEvict
+ * @return A pointer to an empty LRU cache, or NULL if allocation failed
+ */
+LRUCache* create_lrucache(size_t maxEntries, size_t maxBytes, LRUEvictFn onEvict, void* context);
+
+/**
+ * destroyLRUCache
+ *
+ * Destroy the LRU cache. Every remaining value is passed to the eviction
+ * callback before the cache's own memory is freed.
+ *
+ * @param cache A pointer to the LRU cache
+ */
+void destroyLRUCache(LRUCache* cache);
+
+/**
+ * lruGet
+ *
+ * Look up a key and mark its entry as the most recently used.
+ *
+ * @param cache A pointer to the LRU cache
+ * @param key The key to look up
+ * @return the cached value, or NULL if the key is not cached
+ */
+void* lruGet(LRUCache* cache, uintptr_t key);
+
+/**
+ * lruPut
+ *
+ * Insert or replace the value for a key and mark it as the most recently used.
+ * Least recently used entries are evicted until the cache is within its limits.
+ * Evicted entries are reused, so a full cache in steady state never allocates.
+ *
+ * @param cache A pointer to the LRU cache
+ * @param key The key to insert
+ * @param value The value to cache
+ * @param bytes The size to charge against maxBytes for this entry
+ * @return 1 if the value was cached
+ *         0 if the entry is larger than maxBytes or memory ran out
+ */
+int lruPut(LRUCache* cache, uintptr_t key, void* value, size_t bytes);
+
+/**
+ * lruRemove
+ *
+ * Remove a key from the cache without calling the eviction callback.
+ *
+ * @param cache A pointer to the LRU cache
+ * @param key The key to remove
+ * @return the removed value, or NULL if the key is not cached
+ */
+void* lruRemove(LRUCache* cache, uintptr_t key);
+
+/**
+ * lruSize
+ *
+ * Return the number of entries in the LRU cache
+ *
+ * @param cache A pointer to the LRU cache
+ * @return the number of entries
+ */
+int lruSize(LRUCache* cache);
+
+/**
+ * lruBytes
+ *
+ * Return the sum of the sizes of the entries in the LRU cache
+ *
+ * @param cache A pointer to the LRU cache
+ * @return the sum of entry sizes
+ */
+size_t lruBytes(LRUCache* cache);
+#endif
@@ -0,0 +1,95 @@
+// Throughput of the LRU cache under Zipf-distributed keys, compared with the
+// hand-rolled combination of a DLinkedList and a std::unordered_map
+//
+// Usage: ./lru_cache_bench [operations]
+
+#include <stdlib.h>
+#include <unordered_map>
+#include "bench_util.h"
+#include "doublely_linked_list.h"
+#include "lru_cache.h"
+
+#define KEY_SPACE 1000000
+
+// The payload the hand-rolled cache keeps in each list node
+struct GlueEntry {
+	uintptr_t key;
+	void* value;
+};
+
+// Look up each key and insert it on a miss, returning the number of hits
+static size_t run_lru(const uintptr_t* keys, size_t ops, size_t capacity)
+{
+	LRUCache* cache = create_lrucache(capacity, 0, NULL, NULL);
+	size_t hits = 0;
+	for (size_t i = 0; i < ops; i++) {
+		if (lruGet(cache, keys[i]) != NULL) hits++;
+		else lruPut(cache, keys[i], (void*) (keys[i] + 1), 1);
+	}
+	destroyLRUCache(cache);
+	return hits;
+}
+
+static size_t run_glue(const uintptr_t* keys, size_t ops, size_t capacity)
+{
+	DLinkedList* list = create_dlinkedlist();
+	std::unordered_map<uintptr_t, LLNode*> map;
+	size_t hits = 0;
+	for (size_t i = 0; i < ops; i++) {
+		std::unordered_map<uintptr_t, LLNode*>::iterator it = map.find(keys[i]);
+		if (it != map.end()) {
+			// Move the hit to the front
+			hits++;
+			insertNodeHead(list, detachNode(list, it->second));
+			continue;
+		}
+
+		// Evict the tail if full, then insert the new key
+		if ((size_t) getSize(list) == capacity) {
+			getTail(list);
+			GlueEntry* old = (GlueEntry*) removeBackward(list);
+			map.erase(old->key);
+			free(old);
+		}
+		GlueEntry* entry = (GlueEntry*) malloc(sizeof(GlueEntry));
+		entry->key = keys[i];
+		entry->value = (void*) (keys[i] + 1);
+		insertHead(list, entry);
+		map[keys[i]] = list->head;
+	}
+	destroyList(list);
+	return hits;
+}
+
+int main(int argc, char** argv)
+{
+	size_t ops = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000000;
+	double skews[] = {0.8, 0.99, 1.2};
+	size_t capacities[] = {1024, 65536};
+	uintptr_t* keys = (uintptr_t*) malloc(ops * sizeof(uintptr_t));
+
+	for (size_t s = 0; s < sizeof(skews) / sizeof(skews[0]); s++) {
+		// Draw the key sequence up front so the generator stays out of the timing
+		ZipfGen* zipf = create_zipfgen(KEY_SPACE, skews[s]);
+		uint64_t rng = 88172645463325252ULL;
+		for (size_t i = 0; i < ops; i++)
+			keys[i] = zipfNext(zipf, &rng);
+		destroyZipfGen(zipf);
+
+		for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++) {
+			char name[64];
+			double start = benchSeconds();
+			size_t hits = run_lru(keys, ops, capacities[c]);
+			snprintf(name, sizeof(name), "lru  s=%.2f cap=%zu hit=%.1f%%", skews[s], capacities[c], 100.0 * hits / ops);
+			benchReport(name, ops, benchSeconds() - start);
+
+			start = benchSeconds();
+			hits = run_glue(keys, ops, capacities[c]);
+			snprintf(name, sizeof(name), "glue s=%.2f cap=%zu hit=%.1f%%", skews[s], capacities[c], 100.0 * hits / ops);
+			benchReport(name, ops, benchSeconds() - start);
+		}
+	}
+
+	free(keys);
+	return 0;
+}
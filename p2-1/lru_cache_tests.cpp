@@ -0,0 +1,126 @@
+#include "lru_cache.h"
+#include "gtest/gtest.h"
+
+
+// Records the keys handed to the eviction callback, in order
+struct EvictLog {
+	uintptr_t keys[16];
+	int count;
+};
+
+static void log_evict(uintptr_t key, void* value, void* context)
+{
+	(void) value;
+	EvictLog* log = (EvictLog*) context;
+	log->keys[log->count++] = key;
+}
+
+
+TEST(LRUCache, CreateDestroy)
+{
+	LRUCache* cache = create_lrucache(4, 0, NULL, NULL);
+	ASSERT_TRUE(cache != NULL);
+	EXPECT_EQ(0, lruSize(cache));
+	EXPECT_EQ(NULL, lruGet(cache, 1));
+	destroyLRUCache(cache);
+}
+
+TEST(LRUCache, PutGet)
+{
+	int values[3];
+	LRUCache* cache = create_lrucache(4, 0, NULL, NULL);
+
+	// Insert three keys and read them back
+	for (int i = 0; i < 3; i++)
+		ASSERT_EQ(1, lruPut(cache, i, &values[i], 1));
+	EXPECT_EQ(3, lruSize(cache));
+	for (int i = 0; i < 3; i++)
+		EXPECT_EQ(&values[i], lruGet(cache, i));
+	EXPECT_EQ(NULL, lruGet(cache, 3));
+
+	destroyLRUCache(cache);
+}
+
+TEST(LRUCache, EvictLeastRecent)
+{
+	int values[4];
+	EvictLog log = {{0}, 0};
+	LRUCache* cache = create_lrucache(3, 0, log_evict, &log);
+
+	// Fill the cache, then touch key 0 so key 1 is the least recently used
+	for (int i = 0; i < 3; i++)
+		lruPut(cache, i, &values[i], 1);
+	EXPECT_EQ(&values[0], lruGet(cache, 0));
+	LLNode* lru = cache->list->tail;
+
+	// Adding a fourth key should evict key 1 and reuse its entry
+	ASSERT_EQ(1, lruPut(cache, 3, &values[3], 1));
+	EXPECT_EQ(3, lruSize(cache));
+	ASSERT_EQ(1, log.count);
+	EXPECT_EQ(1u, log.keys[0]);
+	EXPECT_EQ(NULL, lruGet(cache, 1));
+	EXPECT_EQ(lru, cache->list->head);
+
+	// Destroying the cache hands over the rest, least recent first
+	destroyLRUCache(cache);
+	ASSERT_EQ(4, log.count);
+	EXPECT_EQ(2u, log.keys[1]);
+	EXPECT_EQ(0u, log.keys[2]);
+	EXPECT_EQ(3u, log.keys[3]);
+}
+
+TEST(LRUCache, ByteLimit)
+{
+	int values[3];
+	EvictLog log = {{0}, 0};
+	LRUCache* cache = create_lrucache(0, 100, log_evict, &log);
+
+	// Two entries fit; the third pushes both of them out
+	ASSERT_EQ(1, lruPut(cache, 0, &values[0], 40));
+	ASSERT_EQ(1, lruPut(cache, 1, &values[1], 40));
+	EXPECT_EQ(80u, lruBytes(cache));
+	ASSERT_EQ(1, lruPut(cache, 2, &values[2], 90));
+	EXPECT_EQ(90u, lruBytes(cache));
+	EXPECT_EQ(1, lruSize(cache));
+	EXPECT_EQ(2, log.count);
+
+	// An entry larger than the cache is rejected outright
+	EXPECT_EQ(0, lruPut(cache, 3, &values[0], 101));
+	EXPECT_EQ(&values[2], lruGet(cache, 2));
+
+	destroyLRUCache(cache);
+}
+
+TEST(LRUCache, Replace)
+{
+	int values[2];
+	EvictLog log = {{0}, 0};
+	LRUCache* cache = create_lrucache(2, 0, log_evict, &log);
+
+	// Replacing a value hands the old one to the callback
+	lruPut(cache, 7, &values[0], 1);
+	ASSERT_EQ(1, lruPut(cache, 7, &values[1], 1));
+	EXPECT_EQ(1, lruSize(cache));
+	EXPECT_EQ(1, log.count);
+	EXPECT_EQ(&values[1], lruGet(cache, 7));
+
+	destroyLRUCache(cache);
+}
+
+TEST(LRUCache, Remove)
+{
+	int values[2];
+	EvictLog log = {{0}, 0};
+	LRUCache* cache = create_lrucache(2, 0, log_evict, &log);
+
+	// Removing a key returns its value without the callback
+	lruPut(cache, 0, &values[0], 5);
+	lruPut(cache, 1, &values[1], 5);
+	EXPECT_EQ(&values[0], lruRemove(cache, 0));
+	EXPECT_EQ(NULL, lruRemove(cache, 0));
+	EXPECT_EQ(1, lruSize(cache));
+	EXPECT_EQ(5u, lruBytes(cache));
+	EXPECT_EQ(0, log.count);
+
+	destroyLRUCache(cache);
+}
@@ -0,0 +1,139 @@
+// A lock-free multi-producer, single-consumer queue of doublely-linked list nodes
+
+#include <stdlib.h>
+#include "mpsc_queue.h"
+
+// Link a node onto the tail. The exchange orders producers; the release store
+// publishes the node to the consumer.
+static void push_node(MPSCQueue* queue, LLNode* node) {
+	__atomic_store_n(&node->next, (LLNode*) NULL, __ATOMIC_RELAXED);
+	LLNode* previous = __atomic_exchange_n(&queue->tail, node, __ATOMIC_ACQ_REL);
+	__atomic_store_n(&previous->next, node, __ATOMIC_RELEASE);
+}
+
+// Hand a consumed node back for reuse. Only the consumer pushes onto the free
+// list and producers only ever take all of it at once, so the head cannot be
+// recycled underneath this compare-and-swap.
+static void recycle_node(MPSCQueue* queue, LLNode* node) {
+	LLNode* top = __atomic_load_n(&queue->freeList, __ATOMIC_RELAXED);
+	do {
+		node->next = top;
+	} while (!__atomic_compare_exchange_n(&queue->freeList, &top, node, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+MPSCQueue* create_mpscqueue(void) {
+	// Create space for the queue
+	MPSCQueue* queue = (MPSCQueue *) malloc(sizeof(MPSCQueue));
+	if (queue == NULL) return NULL;
+
+	// Start with only the stub, which is both head and tail
+	queue->stub.data = NULL;
+	queue->stub.previous = NULL;
+	queue->stub.next = NULL;
+	queue->head = &queue->stub;
+	queue->tail = &queue->stub;
+	queue->freeList = NULL;
+	queue->allocated = 0;
+	return queue;
+}
+
+void destroyMPSCQueue(MPSCQueue* queue) {
+	// Free every node still linked into the queue, skipping the stub
+	LLNode* node = queue->head;
+	while (node != NULL) {
+		LLNode* next = node->next;
+		if (node != &queue->stub) free_llnode(node);
+		node = next;
+	}
+
+	// Free every recycled node
+	node = queue->freeList;
+	while (node != NULL) {
+		LLNode* next = node->next;
+		free_llnode(node);
+		node = next;
+	}
+
+	// Free up the queue's memory
+	free(queue);
+}
+
+MPSCProducer* create_mpscproducer(MPSCQueue* queue) {
+	MPSCProducer* producer = (MPSCProducer *) malloc(sizeof(MPSCProducer));
+	if (producer == NULL) return NULL;
+	producer->queue = queue;
+	producer->cache = NULL;
+	return producer;
+}
+
+void destroyMPSCProducer(MPSCProducer* producer) {
+	// Splice the cached chain back onto the queue's free list
+	if (producer->cache != NULL) {
+		LLNode* last = producer->cache;
+		while (last->next != NULL) last = last->next;
+		LLNode* top = __atomic_load_n(&producer->queue->freeList, __ATOMIC_RELAXED);
+		do {
+			last->next = top;
+		} while (!__atomic_compare_exchange_n(&producer->queue->freeList, &top, producer->cache, 1,
+				__ATOMIC_RELEASE, __ATOMIC_RELAXED));
+	}
+
+	// Free up the handle's memory
+	free(producer);
+}
+
+int mpscInsertTail(MPSCProducer* producer, void* data) {
+	// Refill the cache from the queue's recycled nodes when it runs dry
+	if (producer->cache == NULL)
+		producer->cache = __atomic_exchange_n(&producer->queue->freeList, (LLNode*) NULL, __ATOMIC_ACQUIRE);
+
+	// Take a cached node, or allocate one if nothing has been recycled yet
+	LLNode* node = producer->cache;
+	if (node != NULL) {
+		producer->cache = node->next;
+		node->data = data;
+	} else {
+		node = create_llnode(data);
+		if (node == NULL) return 0;
+		__atomic_fetch_add(&producer->queue->allocated, 1, __ATOMIC_RELAXED);
+	}
+
+	push_node(producer->queue, node);
+	return 1;
+}
+
+void* mpscRemoveHead(MPSCQueue* queue) {
+	LLNode* head = queue->head;
+	LLNode* next = __atomic_load_n(&head->next, __ATOMIC_ACQUIRE);
+
+	// Step past the stub if it is at the head
+	if (head == &queue->stub) {
+		if (next == NULL) return NULL;
+		queue->head = next;
+		head = next;
+		next = __atomic_load_n(&head->next, __ATOMIC_ACQUIRE);
+	}
+
+	// With a successor in place, the head can be taken
+	if (next != NULL) {
+		queue->head = next;
+		void* data = head->data;
+		recycle_node(queue, head);
+		return data;
+	}
+
+	// The head is the last node. If a producer has already exchanged the tail
+	// but not linked its node yet, report empty and let the caller retry.
+	if (head != __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE)) return NULL;
+
+	// Put the stub back behind the last node so it can be taken
+	push_node(queue, &queue->stub);
+	next = __atomic_load_n(&head->next, __ATOMIC_ACQUIRE);
+	if (next != NULL) {
+		queue->head = next;
+		void* data = head->data;
+		recycle_node(queue, head);
+		return data;
+	}
+	return NULL;
+}
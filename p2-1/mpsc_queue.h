@@ -0,0 +1,123 @@
+/** @file mpsc_queue.h */
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <stddef.h>
+#include "doublely_linked_list.h"
+
+/** The cache line size the queue pads its hot fields to */
+#define MPSC_CACHE_LINE 64
+
+
+/********************************************
+ * MPSC queue library functions             *
+ * A lock-free multi-producer, single-      *
+ * consumer queue of LLNodes. Producers     *
+ * append with one atomic exchange on the   *
+ * tail. The consumer unlinks from the head *
+ * with plain loads and stores, then hands  *
+ * the node back for reuse with one         *
+ * compare-and-swap. Taking the last node   *
+ * also re-pushes the stub, which costs an  *
+ * exchange on the tail.                    *
+ ********************************************/
+
+
+/**
+ * This structure represents an entire MPSC queue. Nodes keep the LLNode
+ * layout: next links run from head to tail, and previous is unused.
+ */
+typedef struct mpscqueue_t {
+    /** The most recently pushed node. Producers exchange it. */
+    LLNode* tail;
+    char tailPad[MPSC_CACHE_LINE - sizeof(LLNode*)];
+
+    /** The oldest node, whose data has already been consumed. Consumer only. */
+    LLNode* head;
+
+    /** Placeholder node that keeps the queue non-empty */
+    LLNode stub;
+    char headPad[MPSC_CACHE_LINE - sizeof(LLNode*) - sizeof(LLNode)];
+
+    /** Consumed nodes waiting to be reused, chained through next */
+    LLNode* freeList;
+
+    /** The number of nodes ever allocated by the queue's producers */
+    size_t allocated;
+} MPSCQueue;
+
+/**
+ * This structure represents one producer thread's handle on a queue. It
+ * caches recycled nodes so that pushes in steady state do not allocate.
+ * A producer handle must only be used by one thread at a time.
+ */
+typedef struct mpscproducer_t {
+    /** The queue this producer pushes to */
+    MPSCQueue* queue;
+
+    /** Recycled nodes owned by this producer, chained through next */
+    LLNode* cache;
+} MPSCProducer;
+
+
+/**
+ * create_mpscqueue
+ *
+ * Creates an empty MPSC queue by allocating memory for it on the heap.
+ *
+ * @return A pointer to an empty queue, or NULL if allocation failed
+ */
+MPSCQueue* create_mpscqueue(void);
+
+/**
+ * destroyMPSCQueue
+ *
+ * Destroy the queue and every node it holds. The data is not freed. All
+ * producer handles must be destroyed first.
+ *
+ * @param queue A pointer to the queue
+ */
+void destroyMPSCQueue(MPSCQueue* queue);
+
+/**
+ * create_mpscproducer
+ *
+ * Creates a producer handle for the calling thread.
+ *
+ * @param queue A pointer to the queue to push to
+ * @return A pointer to the producer handle, or NULL if allocation failed
+ */
+MPSCProducer* create_mpscproducer(MPSCQueue* queue);
+
+/**
+ * destroyMPSCProducer
+ *
+ * Return the producer's cached nodes to the queue and free the handle.
+ *
+ * @param producer A pointer to the producer handle
+ */
+void destroyMPSCProducer(MPSCProducer* producer);
+
+/**
+ * mpscInsertTail
+ *
+ * Append data to the tail of the queue. Safe to call from many producers at once.
+ *
+ * @param producer A pointer to the calling thread's producer handle
+ * @param data A void pointer to the data to append. Must not be NULL.
+ * @return 1 if the data was appended
+ *         0 if no node could be allocated
+ */
+int mpscInsertTail(MPSCProducer* producer, void* data);
+
+/**
+ * mpscRemoveHead
+ *
+ * Remove the oldest data from the queue. Only the single consumer thread may
+ * call this. While a push is halfway done the queue can briefly look empty.
+ *
+ * @param queue A pointer to the queue
+ * @return the oldest data, or NULL if the queue is empty
+ */
+void* mpscRemoveHead(MPSCQueue* queue);
+#endif
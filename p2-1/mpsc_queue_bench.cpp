@@ -0,0 +1,87 @@
+// The lock-free MPSC queue against a mutex-guarded DLinkedList task queue
+//
+// Usage: ./mpsc_queue_bench [messages per producer]
+//
+// Thread 0 consumes; every other thread produces. Throughput counts messages
+// delivered.
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "doublely_linked_list.h"
+#include "mpsc_queue.h"
+
+struct Workload {
+	MPSCQueue* queue;
+	DLinkedList* list;
+	pthread_mutex_t mutex;
+	long messages;
+};
+
+static void* lockfree_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	if (t->index == 0) {
+		long expected = w->messages * (t->threads - 1);
+		for (long received = 0; received < expected; )
+			if (mpscRemoveHead(w->queue) != NULL) received++;
+		return NULL;
+	}
+
+	MPSCProducer* producer = create_mpscproducer(w->queue);
+	for (long i = 0; i < w->messages; i++)
+		mpscInsertTail(producer, w);
+	destroyMPSCProducer(producer);
+	return NULL;
+}
+
+static void* mutex_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	if (t->index == 0) {
+		long expected = w->messages * (t->threads - 1);
+		for (long received = 0; received < expected; ) {
+			pthread_mutex_lock(&w->mutex);
+			if (getHead(w->list) != NULL) {
+				removeForward(w->list);
+				received++;
+			}
+			pthread_mutex_unlock(&w->mutex);
+		}
+		return NULL;
+	}
+
+	for (long i = 0; i < w->messages; i++) {
+		pthread_mutex_lock(&w->mutex);
+		insertTail(w->list, w);
+		pthread_mutex_unlock(&w->mutex);
+	}
+	return NULL;
+}
+
+int main(int argc, char** argv)
+{
+	Workload w;
+	w.messages = argc > 1 ? atol(argv[1]) : 200000;
+	pthread_mutex_init(&w.mutex, NULL);
+
+	for (int producers = 1; producers <= 16; producers *= 2) {
+		char name[64];
+		long total = w.messages * producers;
+
+		w.queue = create_mpscqueue();
+		double seconds = benchRunThreads(producers + 1, lockfree_body, &w);
+		snprintf(name, sizeof(name), "lock-free producers=%2d nodes=%zu", producers, w.queue->allocated);
+		benchReport(name, total, seconds);
+		destroyMPSCQueue(w.queue);
+
+		w.list = create_dlinkedlist();
+		seconds = benchRunThreads(producers + 1, mutex_body, &w);
+		snprintf(name, sizeof(name), "mutex     producers=%2d", producers);
+		benchReport(name, total, seconds);
+		destroyList(w.list);
+	}
+
+	pthread_mutex_destroy(&w.mutex);
+	return 0;
+}
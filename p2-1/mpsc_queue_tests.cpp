@@ -0,0 +1,101 @@
+#include <pthread.h>
+#include <stdint.h>
+#include "mpsc_queue.h"
+#include "gtest/gtest.h"
+
+
+#define PRODUCERS 4
+#define ITEMS_PER_PRODUCER 20000
+
+// Pushes (producer << 24 | sequence) for a run of sequence numbers
+static void* producer_thread(void* arg)
+{
+	MPSCQueue* queue = ((MPSCQueue**) arg)[0];
+	uintptr_t id = (uintptr_t) ((MPSCQueue**) arg)[1];
+	MPSCProducer* producer = create_mpscproducer(queue);
+	for (uintptr_t i = 1; i <= ITEMS_PER_PRODUCER; i++)
+		mpscInsertTail(producer, (void*) (id << 24 | i));
+	destroyMPSCProducer(producer);
+	return NULL;
+}
+
+
+TEST(MPSCQueue, CreateDestroy)
+{
+	MPSCQueue* queue = create_mpscqueue();
+	ASSERT_TRUE(queue != NULL);
+	EXPECT_EQ(NULL, mpscRemoveHead(queue));
+	destroyMPSCQueue(queue);
+}
+
+TEST(MPSCQueue, FirstInFirstOut)
+{
+	int items[3];
+	MPSCQueue* queue = create_mpscqueue();
+	MPSCProducer* producer = create_mpscproducer(queue);
+
+	for (int i = 0; i < 3; i++)
+		ASSERT_EQ(1, mpscInsertTail(producer, &items[i]));
+	for (int i = 0; i < 3; i++)
+		EXPECT_EQ(&items[i], mpscRemoveHead(queue));
+	EXPECT_EQ(NULL, mpscRemoveHead(queue));
+
+	// The queue keeps working after it has been drained
+	ASSERT_EQ(1, mpscInsertTail(producer, &items[0]));
+	EXPECT_EQ(&items[0], mpscRemoveHead(queue));
+
+	destroyMPSCProducer(producer);
+	destroyMPSCQueue(queue);
+}
+
+TEST(MPSCQueue, SteadyStateReusesNodes)
+{
+	int item;
+	MPSCQueue* queue = create_mpscqueue();
+	MPSCProducer* producer = create_mpscproducer(queue);
+
+	// Warm up with a burst, then push and pop one at a time
+	for (int i = 0; i < 8; i++)
+		mpscInsertTail(producer, &item);
+	for (int i = 0; i < 8; i++)
+		mpscRemoveHead(queue);
+	size_t allocated = queue->allocated;
+	for (int i = 0; i < 1000; i++) {
+		ASSERT_EQ(1, mpscInsertTail(producer, &item));
+		ASSERT_EQ(&item, mpscRemoveHead(queue));
+	}
+	EXPECT_EQ(allocated, queue->allocated);
+
+	destroyMPSCProducer(producer);
+	destroyMPSCQueue(queue);
+}
+
+TEST(MPSCQueue, ManyProducers)
+{
+	MPSCQueue* queue = create_mpscqueue();
+	pthread_t threads[PRODUCERS];
+	void* args[PRODUCERS][2];
+	for (uintptr_t p = 0; p < PRODUCERS; p++) {
+		args[p][0] = queue;
+		args[p][1] = (void*) p;
+		pthread_create(&threads[p], NULL, producer_thread, args[p]);
+	}
+
+	// Every item arrives once, and each producer's items arrive in order
+	uintptr_t last[PRODUCERS] = {0};
+	int received = 0;
+	while (received < PRODUCERS * ITEMS_PER_PRODUCER) {
+		uintptr_t value = (uintptr_t) mpscRemoveHead(queue);
+		if (value == 0) continue;
+		uintptr_t p = value >> 24, seq = value & 0xffffff;
+		ASSERT_LT(p, (uintptr_t) PRODUCERS);
+		ASSERT_EQ(last[p] + 1, seq);
+		last[p] = seq;
+		received++;
+	}
+	EXPECT_EQ(NULL, mpscRemoveHead(queue));
+
+	for (int p = 0; p < PRODUCERS; p++)
+		pthread_join(threads[p], NULL);
+	destroyMPSCQueue(queue);
+}
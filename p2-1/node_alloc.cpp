@@ -0,0 +1,154 @@
+// Per-thread magazines of free list nodes over a shared depot
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "node_alloc.h"
+
+// A thread's free nodes, chained through next. Only its own thread uses it.
+typedef struct nodecache_t {
+    LLNode* chain;
+    int count;
+    int registered;
+} NodeCache;
+
+static __thread NodeCache thread_cache;
+
+// Full magazines shared by every thread. A magazine is a chain through next;
+// its first node holds the chain's length in data and links to the next
+// magazine through previous.
+static pthread_mutex_t depot_lock = PTHREAD_MUTEX_INITIALIZER;
+static LLNode* depot;
+static size_t depot_count;
+static size_t malloc_count;
+static size_t free_count;
+
+static pthread_once_t key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t exit_key;
+
+// Hand a chain of nodes to the depot, or back to free if it is full
+static void give_magazine(LLNode* chain, int count) {
+	pthread_mutex_lock(&depot_lock);
+	if (depot_count < NODE_DEPOT_MAX) {
+		chain->data = (void*) (intptr_t) count;
+		chain->previous = depot;
+		depot = chain;
+		depot_count++;
+		chain = NULL;
+	} else {
+		free_count += count;
+	}
+	pthread_mutex_unlock(&depot_lock);
+
+	while (chain != NULL) {
+		LLNode* next = chain->next;
+		free(chain);
+		chain = next;
+	}
+}
+
+// Take a magazine from the depot into an empty cache
+static void take_magazine(NodeCache* cache) {
+	pthread_mutex_lock(&depot_lock);
+	LLNode* chain = depot;
+	if (chain != NULL) {
+		depot = chain->previous;
+		depot_count--;
+	}
+	pthread_mutex_unlock(&depot_lock);
+
+	if (chain != NULL) {
+		cache->chain = chain;
+		cache->count = (int) (intptr_t) chain->data;
+	}
+}
+
+// Flush a thread's cache when it exits. Nodes freed by later destructors
+// register the thread again.
+static void thread_exit(void* arg) {
+	nodeAllocFlush();
+	((NodeCache*) arg)->registered = 0;
+}
+
+static void create_key(void) {
+	pthread_key_create(&exit_key, thread_exit);
+}
+
+// Arrange for the cache to be flushed when the calling thread exits
+static void register_thread(NodeCache* cache) {
+	pthread_once(&key_once, create_key);
+	pthread_setspecific(exit_key, cache);
+	cache->registered = 1;
+}
+
+LLNode* nodeAlloc(void) {
+	NodeCache* cache = &thread_cache;
+	if (cache->count == 0) {
+		if (!cache->registered) register_thread(cache);
+		take_magazine(cache);
+	}
+
+	// Pop from the cache when it has anything
+	if (cache->chain != NULL) {
+		LLNode* node = cache->chain;
+		cache->chain = node->next;
+		cache->count--;
+		return node;
+	}
+
+	// Otherwise go to malloc
+	LLNode* node = (LLNode *) malloc(sizeof(LLNode));
+	if (node != NULL) __atomic_fetch_add(&malloc_count, 1, __ATOMIC_RELAXED);
+	return node;
+}
+
+void nodeFree(LLNode* node) {
+	if (node == NULL) return;
+	NodeCache* cache = &thread_cache;
+	if (!cache->registered) register_thread(cache);
+
+	node->next = cache->chain;
+	cache->chain = node;
+	cache->count++;
+
+	// Keep at most two magazines: pass the newest one on to the depot
+	if (cache->count >= 2 * NODE_MAGAZINE_SIZE) {
+		LLNode* chain = cache->chain;
+		LLNode* last = chain;
+		for (int i = 1; i < NODE_MAGAZINE_SIZE; i++) last = last->next;
+		cache->chain = last->next;
+		cache->count -= NODE_MAGAZINE_SIZE;
+		last->next = NULL;
+		give_magazine(chain, NODE_MAGAZINE_SIZE);
+	}
+}
+
+void nodeAllocFlush(void) {
+	NodeCache* cache = &thread_cache;
+	while (cache->chain != NULL) {
+		// Cut off up to one magazine's worth at a time
+		LLNode* chain = cache->chain;
+		LLNode* last = chain;
+		int count = 1;
+		while (count < NODE_MAGAZINE_SIZE && last->next != NULL) {
+			last = last->next;
+			count++;
+		}
+		cache->chain = last->next;
+		last->next = NULL;
+		give_magazine(chain, count);
+	}
+	cache->count = 0;
+}
+
+int nodeCacheCount(void) {
+	return thread_cache.count;
+}
+
+void nodeAllocStats(NodeAllocStats* stats) {
+	pthread_mutex_lock(&depot_lock);
+	stats->mallocs = __atomic_load_n(&malloc_count, __ATOMIC_RELAXED);
+	stats->frees = free_count;
+	stats->depotMagazines = depot_count;
+	pthread_mutex_unlock(&depot_lock);
+}
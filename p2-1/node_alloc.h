@@ -0,0 +1,87 @@
+/** @file node_alloc.h */
+#ifndef NODEALLOC_H
+#define NODEALLOC_H
+
+#include <stddef.h>
+#include "doublely_linked_list.h"
+
+/** The number of nodes moved between a thread's cache and the depot at once */
+#define NODE_MAGAZINE_SIZE 64
+
+/** The most full magazines the depot holds before handing nodes back to free */
+#define NODE_DEPOT_MAX 256
+
+
+/********************************************
+ * Node allocator functions                 *
+ * The allocator behind create_llnode and   *
+ * free_llnode. Each thread keeps up to two *
+ * magazines of free nodes that it can use  *
+ * without locking. Whole magazines move to *
+ * and from a shared depot, so a node freed *
+ * on another thread comes back in a batch. *
+ ********************************************/
+
+
+/**
+ * This structure reports what the allocator has done so far.
+ */
+typedef struct nodeallocstats_t {
+    /** Nodes taken from malloc */
+    size_t mallocs;
+
+    /** Nodes handed back to free because the depot was full */
+    size_t frees;
+
+    /** Full magazines waiting in the depot */
+    size_t depotMagazines;
+} NodeAllocStats;
+
+
+/**
+ * nodeAlloc
+ *
+ * Take a node from the calling thread's cache, refilling it from the depot
+ * if it is empty, or from malloc if the depot is empty too. The node's
+ * fields are not initialized.
+ *
+ * @return A pointer to a node, or NULL if allocation failed
+ */
+LLNode* nodeAlloc(void);
+
+/**
+ * nodeFree
+ *
+ * Put a node in the calling thread's cache. Once the cache holds two
+ * magazines, one of them moves to the depot.
+ *
+ * @param node A pointer to a node from nodeAlloc. NULL is ignored.
+ */
+void nodeFree(LLNode* node);
+
+/**
+ * nodeAllocFlush
+ *
+ * Move every node in the calling thread's cache to the depot. This happens
+ * automatically when a thread exits.
+ */
+void nodeAllocFlush(void);
+
+/**
+ * nodeCacheCount
+ *
+ * Return the number of nodes in the calling thread's cache.
+ *
+ * @return the number of cached nodes
+ */
+int nodeCacheCount(void);
+
+/**
+ * nodeAllocStats
+ *
+ * Fill in the allocator's counters.
+ *
+ * @param stats A pointer to the structure to fill in
+ */
+void nodeAllocStats(NodeAllocStats* stats);
+#endif
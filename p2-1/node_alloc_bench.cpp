@@ -0,0 +1,112 @@
+// Insert/remove churn on DLinkedLists with nodes from malloc against nodes
+// from the per-thread magazines, from 1 to 32 threads
+//
+// Usage: ./node_alloc_bench [rounds per thread] [nodes per round]
+//
+// "local" churns a private list on each thread. "handoff" splices each
+// round's nodes onto a shared list and removes as many from its head, so most
+// nodes are freed on a different thread from the one that made them.
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "doublely_linked_list.h"
+#include "node_alloc.h"
+
+struct Workload {
+	DLinkedList* shared;
+	pthread_mutex_t mutex;
+	int magazines;
+	long rounds;
+	int batch;
+};
+
+// Fill a list with one round's nodes
+static void fill(Workload* w, DLinkedList* list)
+{
+	for (int i = 0; i < w->batch; i++) {
+		if (w->magazines) {
+			insertTail(list, w);
+		} else {
+			LLNode* node = (LLNode *) malloc(sizeof(LLNode));
+			node->data = w;
+			insertNodeTail(list, node);
+		}
+	}
+}
+
+// Remove up to one round's nodes from the head of a list
+static void empty(Workload* w, DLinkedList* list)
+{
+	getHead(list);
+	for (int i = 0; i < w->batch && getCurrent(list) != NULL; i++) {
+		if (w->magazines) removeForward(list);
+		else free(detachNode(list, list->current));
+	}
+}
+
+static void* local_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	DLinkedList* list = create_dlinkedlist();
+	for (long r = 0; r < w->rounds; r++) {
+		fill(w, list);
+		empty(w, list);
+	}
+	destroyList(list);
+	return NULL;
+}
+
+static void* handoff_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	DLinkedList* list = create_dlinkedlist();
+	for (long r = 0; r < w->rounds; r++) {
+		fill(w, list);
+		pthread_mutex_lock(&w->mutex);
+		appendList(w->shared, list);
+		pthread_mutex_unlock(&w->mutex);
+
+		// Detach the oldest nodes under the lock and free them outside it
+		pthread_mutex_lock(&w->mutex);
+		getHead(w->shared);
+		for (int i = 0; i < w->batch && getCurrent(w->shared) != NULL; i++)
+			insertNodeTail(list, detachNode(w->shared, w->shared->current));
+		pthread_mutex_unlock(&w->mutex);
+		empty(w, list);
+	}
+	destroyList(list);
+	return NULL;
+}
+
+int main(int argc, char** argv)
+{
+	Workload w;
+	w.rounds = argc > 1 ? atol(argv[1]) : 20000;
+	w.batch = argc > 2 ? atoi(argv[2]) : 32;
+	pthread_mutex_init(&w.mutex, NULL);
+	w.shared = create_dlinkedlist();
+
+	for (int threads = 1; threads <= 32; threads *= 2) {
+		char name[64];
+		double ops = (double) w.rounds * w.batch * threads;
+		for (w.magazines = 0; w.magazines <= 1; w.magazines++) {
+			const char* source = w.magazines ? "magazine" : "malloc  ";
+			double seconds = benchRunThreads(threads, local_body, &w);
+			snprintf(name, sizeof(name), "local   %s threads=%2d", source, threads);
+			benchReport(name, ops, seconds);
+
+			seconds = benchRunThreads(threads, handoff_body, &w);
+			snprintf(name, sizeof(name), "handoff %s threads=%2d", source, threads);
+			benchReport(name, ops, seconds);
+		}
+	}
+
+	NodeAllocStats stats;
+	nodeAllocStats(&stats);
+	printf("%-44s %zu mallocs, %zu frees, %zu magazines in the depot\n", "  allocator",
+			stats.mallocs, stats.frees, stats.depotMagazines);
+	destroyList(w.shared);
+	pthread_mutex_destroy(&w.mutex);
+	return 0;
+}
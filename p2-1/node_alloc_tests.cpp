@@ -0,0 +1,122 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include "node_alloc.h"
+#include "gtest/gtest.h"
+
+
+#define NODES (4 * NODE_MAGAZINE_SIZE)
+
+// Take every node out of the depot and this thread's cache, so the counters
+// start from nothing. Earlier tests leave nodes behind.
+static LLNode* empty_depot(void)
+{
+	NodeAllocStats stats;
+	LLNode* taken = NULL;
+	nodeAllocFlush();
+	nodeAllocStats(&stats);
+	while (stats.depotMagazines > 0 || nodeCacheCount() > 0) {
+		LLNode* node = nodeAlloc();
+		node->next = taken;
+		taken = node;
+		nodeAllocStats(&stats);
+	}
+	return taken;
+}
+
+// Hand nodes straight back to free, around the caches
+static void release(LLNode* chain)
+{
+	while (chain != NULL) {
+		LLNode* next = chain->next;
+		free(chain);
+		chain = next;
+	}
+}
+
+// Frees every node it is given, then exits
+static void* free_thread(void* arg)
+{
+	LLNode** nodes = (LLNode**) arg;
+	for (int i = 0; i < NODES; i++) free_llnode(nodes[i]);
+	return NULL;
+}
+
+
+TEST(NodeAlloc, ReusesFreedNodes)
+{
+	LLNode* taken = empty_depot();
+	LLNode* node = create_llnode((void*) 1);
+	ASSERT_TRUE(node != NULL);
+	EXPECT_EQ(NULL, node->next);
+	EXPECT_EQ(NULL, node->previous);
+
+	// The most recently freed node comes back first
+	free_llnode(node);
+	EXPECT_EQ(1, nodeCacheCount());
+	LLNode* again = create_llnode((void*) 2);
+	EXPECT_EQ(node, again);
+	EXPECT_EQ((void*) 2, again->data);
+	EXPECT_EQ(0, nodeCacheCount());
+
+	free_llnode(again);
+	free_llnode(NULL);
+	release(taken);
+}
+
+TEST(NodeAlloc, CacheAndDepotAreBounded)
+{
+	LLNode* taken = empty_depot();
+	int count = (NODE_DEPOT_MAX + 2) * NODE_MAGAZINE_SIZE;
+	LLNode** nodes = (LLNode**) malloc(count * sizeof(LLNode*));
+	for (int i = 0; i < count; i++) nodes[i] = nodeAlloc();
+
+	// The cache never holds more than two magazines; the depot takes full
+	// ones until it is full, and the rest go back to free
+	NodeAllocStats before, after;
+	nodeAllocStats(&before);
+	for (int i = 0; i < count; i++) {
+		nodeFree(nodes[i]);
+		ASSERT_LT(nodeCacheCount(), 2 * NODE_MAGAZINE_SIZE);
+	}
+	nodeAllocStats(&after);
+	EXPECT_EQ(NODE_MAGAZINE_SIZE, nodeCacheCount());
+	EXPECT_EQ((size_t) NODE_DEPOT_MAX, after.depotMagazines);
+	EXPECT_EQ((size_t) NODE_MAGAZINE_SIZE, after.frees - before.frees);
+
+	// Everything the depot kept is handed out again without malloc
+	int kept = (NODE_DEPOT_MAX + 1) * NODE_MAGAZINE_SIZE;
+	for (int i = 0; i < kept; i++) nodes[i] = nodeAlloc();
+	nodeAllocStats(&after);
+	EXPECT_EQ(before.mallocs, after.mallocs);
+	EXPECT_EQ(0u, after.depotMagazines);
+
+	for (int i = 0; i < kept; i++) nodeFree(nodes[i]);
+	free(nodes);
+	release(taken);
+}
+
+TEST(NodeAlloc, CrossThreadFreesComeBackInMagazines)
+{
+	LLNode* taken = empty_depot();
+	LLNode* nodes[NODES];
+	for (int i = 0; i < NODES; i++) nodes[i] = create_llnode(NULL);
+
+	// Another thread frees them; its cache is flushed when it exits
+	NodeAllocStats before, after;
+	nodeAllocStats(&before);
+	pthread_t thread;
+	ASSERT_EQ(0, pthread_create(&thread, NULL, free_thread, nodes));
+	pthread_join(thread, NULL);
+	nodeAllocStats(&after);
+	EXPECT_EQ((size_t) NODES / NODE_MAGAZINE_SIZE, after.depotMagazines);
+
+	// This thread gets them back a magazine at a time
+	nodes[0] = create_llnode(NULL);
+	EXPECT_EQ(NODE_MAGAZINE_SIZE - 1, nodeCacheCount());
+	for (int i = 1; i < NODES; i++) nodes[i] = create_llnode(NULL);
+	nodeAllocStats(&after);
+	EXPECT_EQ(before.mallocs, after.mallocs);
+
+	for (int i = 0; i < NODES; i++) free_llnode(nodes[i]);
+	release(taken);
+}
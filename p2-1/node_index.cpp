@@ -0,0 +1,119 @@
+// An open-addressing index from keys to doublely-linked list nodes
+
+#include <stdlib.h>
+#include "node_index.h"
+
+// The smallest slot array the index will allocate
+#define NODEINDEX_MIN_CAPACITY 16
+
+static size_t home_slot(NodeIndex* index, uintptr_t key) {
+	return (size_t) hashKey(key) & (index->capacity - 1);
+}
+
+static int resize_index(NodeIndex* index, size_t capacity) {
+	// Allocate the new, empty slot array
+	NodeIndexSlot* slots = (NodeIndexSlot *) calloc(capacity, sizeof(NodeIndexSlot));
+	if (slots == NULL) return 0;
+
+	// Swap the arrays and reinsert every occupied slot
+	NodeIndexSlot* oldSlots = index->slots;
+	size_t oldCapacity = index->capacity;
+	index->slots = slots;
+	index->capacity = capacity;
+	for (size_t i = 0; i < oldCapacity; i++) {
+		if (oldSlots[i].node == NULL) continue;
+		size_t j = home_slot(index, oldSlots[i].key);
+		while (slots[j].node != NULL) j = (j + 1) & (capacity - 1);
+		slots[j] = oldSlots[i];
+	}
+
+	free(oldSlots);
+	return 1;
+}
+
+NodeIndex* create_nodeindex(void) {
+	// Create space for the index and its first slot array
+	NodeIndex* index = (NodeIndex *) malloc(sizeof(NodeIndex));
+	if (index == NULL) return NULL;
+	index->slots = (NodeIndexSlot *) calloc(NODEINDEX_MIN_CAPACITY, sizeof(NodeIndexSlot));
+	if (index->slots == NULL) {
+		free(index);
+		return NULL;
+	}
+
+	// Initialize the counters
+	index->capacity = NODEINDEX_MIN_CAPACITY;
+	index->size = 0;
+	return index;
+}
+
+void destroyNodeIndex(NodeIndex* index) {
+	free(index->slots);
+	free(index);
+}
+
+int nodeIndexPut(NodeIndex* index, uintptr_t key, struct llnode_t* node) {
+	// Keep the load factor at or below one half so probe runs stay short
+	if ((index->size + 1) * 2 > index->capacity) {
+		if (!resize_index(index, index->capacity * 2)) return 0;
+	}
+
+	// Probe until we find the key or an empty slot
+	size_t i = home_slot(index, key);
+	while (index->slots[i].node != NULL) {
+		if (index->slots[i].key == key) {
+			index->slots[i].node = node;
+			return 1;
+		}
+		i = (i + 1) & (index->capacity - 1);
+	}
+
+	// Claim the empty slot
+	index->slots[i].key = key;
+	index->slots[i].node = node;
+	index->size++;
+	return 1;
+}
+
+struct llnode_t* nodeIndexGet(NodeIndex* index, uintptr_t key) {
+	// Probe until we find the key or an empty slot
+	size_t i = home_slot(index, key);
+	while (index->slots[i].node != NULL) {
+		if (index->slots[i].key == key) return index->slots[i].node;
+		i = (i + 1) & (index->capacity - 1);
+	}
+
+	// Return NULL otherwise
+	return NULL;
+}
+
+struct llnode_t* nodeIndexRemove(NodeIndex* index, uintptr_t key, struct llnode_t* node) {
+	// Find the slot holding the key
+	size_t mask = index->capacity - 1;
+	size_t i = home_slot(index, key);
+	while (index->slots[i].node != NULL && index->slots[i].key != key) i = (i + 1) & mask;
+	if (index->slots[i].node == NULL) return NULL;
+	if (node != NULL && index->slots[i].node != node) return NULL;
+	struct llnode_t* removed = index->slots[i].node;
+
+	// Shift later members of the probe run back into the hole, unless they
+	// would move in front of their home slot
+	size_t j = i;
+	while (1) {
+		index->slots[i].node = NULL;
+		do {
+			j = (j + 1) & mask;
+			if (index->slots[j].node == NULL) {
+				index->size--;
+				return removed;
+			}
+		} while (((j - home_slot(index, index->slots[j].key)) & mask) < ((j - i) & mask));
+		index->slots[i] = index->slots[j];
+		i = j;
+	}
+}
+
+void nodeIndexClear(NodeIndex* index) {
+	for (size_t i = 0; i < index->capacity; i++) index->slots[i].node = NULL;
+	index->size = 0;
+}
@@ -0,0 +1,129 @@
+/** @file node_index.h */
+#ifndef NODEINDEX_H
+#define NODEINDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct llnode_t;
+
+
+/********************************************
+ * Node index library functions             *
+ * An open-addressing hash table that maps  *
+ * a word-sized key (usually a data         *
+ * pointer) to the list node holding it.    *
+ ********************************************/
+
+
+/**
+ * This structure represents a single slot of the index. A slot is empty
+ * when its node pointer is NULL.
+ */
+typedef struct nodeindexslot_t {
+    /** The key stored in this slot */
+    uintptr_t key;
+
+    /** The node the key maps to. NULL if the slot is empty. */
+    struct llnode_t* node;
+} NodeIndexSlot;
+
+/**
+ * This structure represents an entire node index.
+ */
+typedef struct nodeindex_t {
+    /** The slot array. Its length is always a power of two. */
+    NodeIndexSlot* slots;
+
+    /** The number of slots in the slot array */
+    size_t capacity;
+
+    /** The number of occupied slots */
+    size_t size;
+} NodeIndex;
+
+
+/**
+ * hashKey
+ *
+ * Mix the bits of a key so that pointers, which share their low and high bits,
+ * spread evenly over a power-of-two table.
+ *
+ * @param key The key to hash
+ * @return The mixed hash value
+ */
+static inline uint64_t hashKey(uintptr_t key) {
+    uint64_t h = (uint64_t) key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * create_nodeindex
+ *
+ * Creates an empty node index by allocating memory for it on the heap.
+ *
+ * @return A pointer to an empty node index, or NULL if allocation failed
+ */
+NodeIndex* create_nodeindex(void);
+
+/**
+ * destroyNodeIndex
+ *
+ * Free the node index. The nodes it points to are not touched.
+ *
+ * @param index A pointer to the node index
+ */
+void destroyNodeIndex(NodeIndex* index);
+
+/**
+ * nodeIndexPut
+ *
+ * Map the key to the node. If the key is already present its node is replaced.
+ * The slot array doubles whenever it becomes more than half full.
+ *
+ * @param index A pointer to the node index
+ * @param key The key to insert
+ * @param node The node the key maps to. Must not be NULL.
+ * @return 1 if the key was stored
+ *         0 if the slot array could not grow
+ */
+int nodeIndexPut(NodeIndex* index, uintptr_t key, struct llnode_t* node);
+
+/**
+ * nodeIndexGet
+ *
+ * Look up the node a key maps to.
+ *
+ * @param index A pointer to the node index
+ * @param key The key to look up
+ * @return The node, or NULL if the key is not present
+ */
+struct llnode_t* nodeIndexGet(NodeIndex* index, uintptr_t key);
+
+/**
+ * nodeIndexRemove
+ *
+ * Remove the key from the index. Deletion shifts the following probe run back
+ * so the table never accumulates tombstones.
+ *
+ * @param index A pointer to the node index
+ * @param key The key to remove
+ * @param node If non-NULL, the key is only removed when it maps to this node
+ * @return The node the key mapped to, or NULL if nothing was removed
+ */
+struct llnode_t* nodeIndexRemove(NodeIndex* index, uintptr_t key, struct llnode_t* node);
+
+/**
+ * nodeIndexClear
+ *
+ * Remove every key from the index without shrinking the slot array.
+ *
+ * @param index A pointer to the node index
+ */
+void nodeIndexClear(NodeIndex* index);
+#endif
@@ -0,0 +1,202 @@
+// A Robin Hood open-addressing hash map
+
+#include <stdlib.h>
+#include "node_index.h"
+#include "open_hash_map.h"
+
+// The smallest slot array the map will allocate
+#define OA_MIN_CAPACITY 16
+
+// Probe distances are stored in a byte, offset by one
+#define OA_MAX_DISTANCE 255
+
+// Check that a key can be placed without the probe reaching OA_MAX_DISTANCE.
+// Displacing an entry only swaps which distance is carried on, so the probe
+// can be followed through the distances alone, before anything is moved.
+static int entry_fits(OAHashMap* map, uintptr_t key) {
+	size_t mask = map->capacity - 1;
+	size_t i = (size_t) hashKey(key) & mask;
+	unsigned distance = 1;
+	while (map->distance[i] != 0) {
+		if (map->distance[i] < distance) distance = map->distance[i];
+		i = (i + 1) & mask;
+		if (++distance == OA_MAX_DISTANCE) return 0;
+	}
+	return 1;
+}
+
+// Place a key that is known not to be in the map. Entries that sit closer to
+// their home slot than the incoming one are displaced and carried forward.
+// Returns 0 without changing the map if the probe would grow too long.
+static int place_entry(OAHashMap* map, uintptr_t key, void* value) {
+	if (!entry_fits(map, key)) return 0;
+	size_t mask = map->capacity - 1;
+	size_t i = (size_t) hashKey(key) & mask;
+	unsigned distance = 1;
+	while (1) {
+		// Claim an empty slot
+		if (map->distance[i] == 0) {
+			map->distance[i] = (uint8_t) distance;
+			map->slots[i].key = key;
+			map->slots[i].value = value;
+			return 1;
+		}
+
+		// Take the slot from a richer entry and carry that one on instead
+		if (map->distance[i] < distance) {
+			OASlot slot = map->slots[i];
+			unsigned slotDistance = map->distance[i];
+			map->slots[i].key = key;
+			map->slots[i].value = value;
+			map->distance[i] = (uint8_t) distance;
+			key = slot.key;
+			value = slot.value;
+			distance = slotDistance;
+		}
+		i = (i + 1) & mask;
+		distance++;
+	}
+}
+
+// Move every entry into arrays of the given capacity. Either all of them move
+// or, if allocation fails or an entry does not fit, the map is unchanged.
+static int resize_map(OAHashMap* map, size_t capacity) {
+	// Allocate the new, empty arrays
+	OASlot* slots = (OASlot *) malloc(capacity * sizeof(OASlot));
+	uint8_t* distance = (uint8_t *) calloc(capacity, sizeof(uint8_t));
+	if (slots == NULL || distance == NULL) {
+		free(slots);
+		free(distance);
+		return 0;
+	}
+
+	// Swap the arrays and reinsert every entry
+	OASlot* oldSlots = map->slots;
+	uint8_t* oldDistance = map->distance;
+	size_t oldCapacity = map->capacity;
+	map->slots = slots;
+	map->distance = distance;
+	map->capacity = capacity;
+	for (size_t i = 0; i < oldCapacity; i++) {
+		if (oldDistance[i] != 0 && !place_entry(map, oldSlots[i].key, oldSlots[i].value)) {
+			// Put the old arrays back; they still hold every entry
+			map->slots = oldSlots;
+			map->distance = oldDistance;
+			map->capacity = oldCapacity;
+			free(slots);
+			free(distance);
+			return 0;
+		}
+	}
+
+	free(oldSlots);
+	free(oldDistance);
+	return 1;
+}
+
+// Find the slot holding a key. A key at probe distance d can only be in a slot
+// whose stored distance is exactly d, and the probe can stop at the first slot
+// whose entry is closer to home than d.
+static size_t find_slot(OAHashMap* map, uintptr_t key) {
+	size_t mask = map->capacity - 1;
+	size_t i = (size_t) hashKey(key) & mask;
+	unsigned distance = 1;
+	while (map->distance[i] >= distance) {
+		if (map->distance[i] == distance && map->slots[i].key == key) return i;
+		i = (i + 1) & mask;
+		distance++;
+	}
+	return map->capacity;
+}
+
+OAHashMap* create_oahashmap(double maxLoad) {
+	// Create space for the map
+	OAHashMap* map = (OAHashMap *) malloc(sizeof(OAHashMap));
+	if (map == NULL) return NULL;
+	map->slots = (OASlot *) malloc(OA_MIN_CAPACITY * sizeof(OASlot));
+	map->distance = (uint8_t *) calloc(OA_MIN_CAPACITY, sizeof(uint8_t));
+	if (map->slots == NULL || map->distance == NULL) {
+		free(map->slots);
+		free(map->distance);
+		free(map);
+		return NULL;
+	}
+
+	// Initialize the counters and clamp the load factor
+	map->capacity = OA_MIN_CAPACITY;
+	map->size = 0;
+	if (maxLoad < 0.1) maxLoad = 0.1;
+	if (maxLoad > 0.95) maxLoad = 0.95;
+	map->maxLoad = maxLoad;
+	return map;
+}
+
+void destroyOAHashMap(OAHashMap* map) {
+	free(map->slots);
+	free(map->distance);
+	free(map);
+}
+
+int oaInsert(OAHashMap* map, uintptr_t key, void* value) {
+	// Replace the value in place if the key is already present
+	size_t i = find_slot(map, key);
+	if (i != map->capacity) {
+		map->slots[i].value = value;
+		return 1;
+	}
+
+	// Grow before the new entry would push us past the maximum load
+	if ((double) (map->size + 1) > map->capacity * map->maxLoad) {
+		if (!resize_map(map, map->capacity * 2)) return 0;
+	}
+
+	// Grow until the probe fits. This is not expected to happen at any load
+	// factor the map accepts.
+	while (!place_entry(map, key, value)) {
+		if (!resize_map(map, map->capacity * 2)) return 0;
+	}
+	map->size++;
+	return 1;
+}
+
+void* oaLookup(OAHashMap* map, uintptr_t key) {
+	// Only return the value if the key is present
+	size_t i = find_slot(map, key);
+	if (i != map->capacity) return map->slots[i].value;
+
+	// Return NULL otherwise
+	return NULL;
+}
+
+void* oaRemove(OAHashMap* map, uintptr_t key) {
+	// Only remove the entry if the key is present
+	size_t i = find_slot(map, key);
+	if (i == map->capacity) return NULL;
+	void* value = map->slots[i].value;
+
+	// Shift the rest of the probe run back one slot
+	size_t mask = map->capacity - 1;
+	size_t j = (i + 1) & mask;
+	while (map->distance[j] > 1) {
+		map->slots[i] = map->slots[j];
+		map->distance[i] = map->distance[j] - 1;
+		i = j;
+		j = (j + 1) & mask;
+	}
+	map->distance[i] = 0;
+	map->size--;
+
+	// Shrink once the map is a quarter of the way to its maximum load.
+	// A failed shrink just leaves the map larger than it needs to be.
+	if (map->capacity > OA_MIN_CAPACITY && map->size < map->capacity * map->maxLoad / 4)
+		resize_map(map, map->capacity / 2);
+	return value;
+}
+
+size_t oaSize(OAHashMap* map) {
+	return map->size;
+}
+
+double oaLoadFactor(OAHashMap* map) {
+	return (double) map->size / map->capacity;
+}
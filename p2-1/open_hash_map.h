@@ -0,0 +1,126 @@
+/** @file open_hash_map.h */
+#ifndef OPENHASHMAP_H
+#define OPENHASHMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/********************************************
+ * Open-addressing hash map functions       *
+ * A Robin Hood hash map with the same      *
+ * insert, lookup and remove API as the     *
+ * chained HashTable, but no per-entry      *
+ * allocation and no pointer chasing.       *
+ ********************************************/
+
+
+/**
+ * This structure represents a single slot of the map.
+ */
+typedef struct oaslot_t {
+    /** The key stored in this slot */
+    uintptr_t key;
+
+    /** The value stored under the key */
+    void* value;
+} OASlot;
+
+/**
+ * This structure represents an entire open-addressing hash map. Probe
+ * distances are kept in their own byte array so a probe scans densely packed
+ * metadata and only touches a slot when its distance says the key could be there.
+ */
+typedef struct oahashmap_t {
+    /** The slot array. Its length is always a power of two. */
+    OASlot* slots;
+
+    /** Per-slot probe distance plus one. 0 marks an empty slot. */
+    uint8_t* distance;
+
+    /** The number of slots */
+    size_t capacity;
+
+    /** The number of entries in the map */
+    size_t size;
+
+    /** The load factor the map grows at */
+    double maxLoad;
+} OAHashMap;
+
+
+/**
+ * create_oahashmap
+ *
+ * Creates an empty open-addressing hash map by allocating memory for it on the heap.
+ *
+ * @param maxLoad The load factor at which the map doubles, between 0.1 and 0.95.
+ *                Values outside that range are clamped.
+ * @return A pointer to an empty map, or NULL if allocation failed
+ */
+OAHashMap* create_oahashmap(double maxLoad);
+
+/**
+ * destroyOAHashMap
+ *
+ * Destroy the map. The values are not freed.
+ *
+ * @param map A pointer to the map
+ */
+void destroyOAHashMap(OAHashMap* map);
+
+/**
+ * oaInsert
+ *
+ * Store a value under a key, replacing any value already stored there.
+ *
+ * @param map A pointer to the map
+ * @param key The key to store the value under
+ * @param value The value to store
+ * @return 1 if the value was stored
+ *         0 if memory ran out; the map is unchanged
+ */
+int oaInsert(OAHashMap* map, uintptr_t key, void* value);
+
+/**
+ * oaLookup
+ *
+ * Look up the value stored under a key.
+ *
+ * @param map A pointer to the map
+ * @param key The key to look up
+ * @return the value, or NULL if the key is not in the map
+ */
+void* oaLookup(OAHashMap* map, uintptr_t key);
+
+/**
+ * oaRemove
+ *
+ * Remove a key and return the value stored under it.
+ *
+ * @param map A pointer to the map
+ * @param key The key to remove
+ * @return the removed value, or NULL if the key is not in the map
+ */
+void* oaRemove(OAHashMap* map, uintptr_t key);
+
+/**
+ * oaSize
+ *
+ * Return the number of entries in the map
+ *
+ * @param map A pointer to the map
+ * @return the number of entries
+ */
+size_t oaSize(OAHashMap* map);
+
+/**
+ * oaLoadFactor
+ *
+ * Return the fraction of slots in use
+ *
+ * @param map A pointer to the map
+ * @return the load factor
+ */
+double oaLoadFactor(OAHashMap* map);
+#endif
@@ -0,0 +1,114 @@
+// The Robin Hood open-addressing map against the DLinkedList-chained HashTable
+// at a range of load factors
+//
+// Usage: ./open_hash_map_bench [log2 of the bucket count]
+//
+// Each run grows both maps to the same number of buckets/slots and then removes
+// keys down to the target load, so the load factor printed is the one both
+// were measured at.
+
+#include <stdlib.h>
+#include "bench_util.h"
+#include "hash_table.h"
+#include "open_hash_map.h"
+
+// Adapters so one driver can time both maps
+struct MapOps {
+	const char* name;
+	void* (*create)(void);
+	void (*destroy)(void*);
+	int (*insert)(void*, uintptr_t, void*);
+	void* (*lookup)(void*, uintptr_t);
+	void* (*remove)(void*, uintptr_t);
+	double (*load)(void*);
+};
+
+static void* chained_create(void) { return create_hashtable(); }
+static void chained_destroy(void* m) { destroyHashTable((HashTable*) m); }
+static int chained_insert(void* m, uintptr_t k, void* v) { return htInsert((HashTable*) m, k, v); }
+static void* chained_lookup(void* m, uintptr_t k) { return htLookup((HashTable*) m, k); }
+static void* chained_remove(void* m, uintptr_t k) { return htRemove((HashTable*) m, k); }
+static double chained_load(void* m) { return htLoadFactor((HashTable*) m); }
+
+static void* open_create(void) { return create_oahashmap(0.95); }
+static void open_destroy(void* m) { destroyOAHashMap((OAHashMap*) m); }
+static int open_insert(void* m, uintptr_t k, void* v) { return oaInsert((OAHashMap*) m, k, v); }
+static void* open_lookup(void* m, uintptr_t k) { return oaLookup((OAHashMap*) m, k); }
+static void* open_remove(void* m, uintptr_t k) { return oaRemove((OAHashMap*) m, k); }
+static double open_load(void* m) { return oaLoadFactor((OAHashMap*) m); }
+
+static const MapOps maps[] = {
+	{"chained", chained_create, chained_destroy, chained_insert, chained_lookup, chained_remove, chained_load},
+	{"robin hood", open_create, open_destroy, open_insert, open_lookup, open_remove, open_load},
+};
+
+static void run(const MapOps* ops, const uintptr_t* keys, size_t full, size_t n, const uintptr_t* misses)
+{
+	char name[64];
+	void* map = ops->create();
+
+	// Grow the map, then remove keys until it is at the target load
+	double start = benchSeconds();
+	for (size_t i = 0; i < full; i++)
+		ops->insert(map, keys[i], (void*) (keys[i] | 1));
+	double seconds = benchSeconds() - start;
+	for (size_t i = n; i < full; i++)
+		ops->remove(map, keys[i]);
+	double load = ops->load(map);
+	snprintf(name, sizeof(name), "%-10s load=%.2f insert", ops->name, load);
+	benchReport(name, full, seconds);
+
+	// Look up keys that are present, then keys that are not
+	size_t found = 0;
+	start = benchSeconds();
+	for (size_t i = 0; i < n; i++)
+		found += ops->lookup(map, keys[(i * 7919) % n]) != NULL;
+	snprintf(name, sizeof(name), "%-10s load=%.2f lookup hit", ops->name, load);
+	benchReport(name, n, benchSeconds() - start);
+
+	start = benchSeconds();
+	for (size_t i = 0; i < n; i++)
+		found += ops->lookup(map, misses[i]) != NULL;
+	snprintf(name, sizeof(name), "%-10s load=%.2f lookup miss", ops->name, load);
+	benchReport(name, n, benchSeconds() - start);
+
+	// Churn: remove a key and put it straight back
+	start = benchSeconds();
+	for (size_t i = 0; i < n; i++) {
+		uintptr_t key = keys[(i * 104729) % n];
+		ops->remove(map, key);
+		ops->insert(map, key, (void*) (key | 1));
+	}
+	snprintf(name, sizeof(name), "%-10s load=%.2f remove+insert", ops->name, load);
+	benchReport(name, n, benchSeconds() - start);
+
+	if (found != n) printf("unexpected lookup result count %zu\n", found);
+	ops->destroy(map);
+}
+
+int main(int argc, char** argv)
+{
+	int bits = argc > 1 ? atoi(argv[1]) : 18;
+	size_t buckets = (size_t) 1 << bits;
+	double loads[] = {0.25, 0.5, 0.75, 0.9};
+
+	// Random keys to insert, and a disjoint set to miss with
+	uintptr_t* keys = (uintptr_t*) malloc(buckets * sizeof(uintptr_t));
+	uintptr_t* misses = (uintptr_t*) malloc(buckets * sizeof(uintptr_t));
+	size_t full = buckets * 95 / 100;
+	uint64_t rng = 88172645463325252ULL;
+	for (size_t i = 0; i < buckets; i++) {
+		keys[i] = (uintptr_t) (benchRandom(&rng) << 1);
+		misses[i] = (uintptr_t) (benchRandom(&rng) << 1) | 1;
+	}
+
+	for (size_t l = 0; l < sizeof(loads) / sizeof(loads[0]); l++) {
+		size_t n = (size_t) (buckets * loads[l]);
+		for (size_t m = 0; m < sizeof(maps) / sizeof(maps[0]); m++)
+			run(&maps[m], keys, full, n, misses);
+	}
+
+	free(keys);
+	free(misses);
+	return 0;
+}
@@ -0,0 +1,102 @@
+#include "hash_table.h"
+#include "node_index.h"
+#include "open_hash_map.h"
+#include "gtest/gtest.h"
+
+
+TEST(OAHashMap, CreateDestroy)
+{
+	OAHashMap* map = create_oahashmap(0.875);
+	ASSERT_TRUE(map != NULL);
+	EXPECT_EQ(0u, oaSize(map));
+	EXPECT_EQ(NULL, oaLookup(map, 1));
+	destroyOAHashMap(map);
+}
+
+TEST(OAHashMap, InsertLookupRemove)
+{
+	int values[3];
+	OAHashMap* map = create_oahashmap(0.875);
+
+	// Insert three keys, replacing the value of the last one
+	ASSERT_EQ(1, oaInsert(map, 10, &values[0]));
+	ASSERT_EQ(1, oaInsert(map, 20, &values[1]));
+	ASSERT_EQ(1, oaInsert(map, 30, &values[1]));
+	ASSERT_EQ(1, oaInsert(map, 30, &values[2]));
+	EXPECT_EQ(3u, oaSize(map));
+
+	// Check the lookups
+	EXPECT_EQ(&values[0], oaLookup(map, 10));
+	EXPECT_EQ(&values[1], oaLookup(map, 20));
+	EXPECT_EQ(&values[2], oaLookup(map, 30));
+	EXPECT_EQ(NULL, oaLookup(map, 40));
+
+	// Remove one key
+	EXPECT_EQ(&values[1], oaRemove(map, 20));
+	EXPECT_EQ(NULL, oaRemove(map, 20));
+	EXPECT_EQ(NULL, oaLookup(map, 20));
+	EXPECT_EQ(2u, oaSize(map));
+
+	destroyOAHashMap(map);
+}
+
+TEST(OAHashMap, LongProbeGrows)
+{
+	// Find keys that all share home slot 0 in every table up to 512 slots
+	uintptr_t keys[300];
+	int n = 0;
+	for (uintptr_t key = 1; n < 300; key++)
+		if ((hashKey(key) & 511) == 0) keys[n++] = key;
+
+	// Past 254 of them the probe is too long for 512 slots, so the map grows
+	// rather than dropping an entry it was carrying
+	OAHashMap* map = create_oahashmap(0.95);
+	for (int i = 0; i < n; i++) ASSERT_EQ(1, oaInsert(map, keys[i], &keys[i]));
+	EXPECT_EQ((size_t) n, oaSize(map));
+	EXPECT_GT(map->capacity, 512u);
+	for (int i = 0; i < n; i++) EXPECT_EQ(&keys[i], oaLookup(map, keys[i]));
+
+	destroyOAHashMap(map);
+}
+
+TEST(OAHashMap, LoadFactorBound)
+{
+	double loads[] = {0.5, 0.75, 0.95};
+	for (size_t l = 0; l < 3; l++) {
+		OAHashMap* map = create_oahashmap(loads[l]);
+		for (uintptr_t i = 0; i < 10000; i++) {
+			ASSERT_EQ(1, oaInsert(map, i * 7919, (void*) (i + 1)));
+			ASSERT_LE(oaLoadFactor(map), loads[l]);
+		}
+		for (uintptr_t i = 0; i < 10000; i++)
+			ASSERT_EQ((void*) (i + 1), oaLookup(map, i * 7919));
+		destroyOAHashMap(map);
+	}
+}
+
+TEST(OAHashMap, MatchesChainedTable)
+{
+	// Drive both maps with the same random operations and compare every result
+	HashTable* table = create_hashtable();
+	OAHashMap* map = create_oahashmap(0.875);
+	unsigned seed = 12345;
+	for (int i = 0; i < 50000; i++) {
+		seed = seed * 1103515245 + 12345;
+		uintptr_t key = (seed >> 8) % 2000;
+		void* value = (void*) (uintptr_t) (i + 1);
+		switch ((seed >> 4) % 3) {
+		case 0:
+			ASSERT_EQ(htInsert(table, key, value), oaInsert(map, key, value));
+			break;
+		case 1:
+			ASSERT_EQ(htLookup(table, key), oaLookup(map, key));
+			break;
+		default:
+			ASSERT_EQ(htRemove(table, key), oaRemove(map, key));
+			break;
+		}
+		ASSERT_EQ(htSize(table), oaSize(map));
+	}
+	destroyHashTable(table);
+	destroyOAHashMap(map);
+}
@@ -1,2 +1,2 @@
-g++ -g -Wall -Wextra -pthread doublely_linked_list.cpp -lpthread dll_tests.o gtest_main.a -o dll_tests
+g++ -g -Wall -Wextra -pthread doublely_linked_list.cpp node_alloc.cpp node_index.cpp -lpthread dll_tests.o gtest_main.a -o dll_tests
 ./dll_tests
@@ -0,0 +1,38 @@
+/** @file pmr_nodes.h */
+#ifndef PMRNODES_H
+#define PMRNODES_H
+
+#include <memory_resource>
+#include <new>
+#include "policy_list.h"
+
+
+/********************************************
+ * Polymorphic allocator policy             *
+ * A PolicyList allocator policy backed by  *
+ * std::pmr. It lives apart from the policy *
+ * core so only lists that use it need      *
+ * C++17's <memory_resource>.               *
+ ********************************************/
+
+
+/** Nodes from a std::pmr::memory_resource, such as a monotonic buffer for a
+    request-scoped list. The resource must outlive the list. */
+struct PmrNodes {
+    /** Where nodes come from */
+    std::pmr::memory_resource* resource;
+
+    PmrNodes() : resource(std::pmr::get_default_resource()) {}
+    explicit PmrNodes(std::pmr::memory_resource* r) : resource(r) {}
+
+    LLNode* allocate() {
+        try {
+            return (LLNode *) resource->allocate(sizeof(LLNode), alignof(LLNode));
+        } catch (const std::bad_alloc&) {
+            return NULL;
+        }
+    }
+
+    void deallocate(LLNode* node) { resource->deallocate(node, sizeof(LLNode), alignof(LLNode)); }
+};
+#endif
@@ -0,0 +1,303 @@
+/** @file policy_list.h */
+#ifndef POLICYLIST_H
+#define POLICYLIST_H
+
+#include <stdlib.h>
+#include "doublely_linked_list.h"
+
+
+/********************************************
+ * Policy-based list library                *
+ * A header-only C++ list of LLNodes whose  *
+ * node allocator, locking and size         *
+ * tracking are chosen at compile time.     *
+ * Empty policies take no space and their   *
+ * calls inline to nothing, so              *
+ * PolicyList<MagazineNodes, NoLock,        *
+ * CountSize> runs the same code as a       *
+ * DLinkedList without an index.            *
+ ********************************************/
+
+
+/********************************************
+ * Allocator policies                       *
+ * LLNode* allocate() and                   *
+ * void deallocate(LLNode*). The ones that  *
+ * use the heap are in list_policies.h, and *
+ * PmrNodes is in pmr_nodes.h.              *
+ ********************************************/
+
+/** The default allocator policy, defined in list_policies.h */
+struct MagazineNodes;
+
+
+/********************************************
+ * Locking policies                         *
+ * void lock() and void unlock(), held for  *
+ * the whole of each list call. MutexLock   *
+ * is in list_policies.h.                   *
+ ********************************************/
+
+/** No locking, for lists only one thread uses */
+struct NoLock {
+    void lock() {}
+    void unlock() {}
+};
+
+
+/********************************************
+ * Size-tracking policies                   *
+ * added(), removed(), reset() and a        *
+ * count(head)                              *
+ ********************************************/
+
+/** Keep a counter, so getSize is O(1) */
+struct CountSize {
+    /** The number of nodes in the list */
+    int size;
+
+    CountSize() : size(0) {}
+    void added() { size++; }
+    void removed() { size--; }
+    void reset() { size = 0; }
+    int count(LLNode*) const { return size; }
+};
+
+/** Keep no counter, so inserts and removes skip the update and getSize
+    walks the list */
+struct NoSize {
+    void added() {}
+    void removed() {}
+    void reset() {}
+    int count(LLNode* node) const {
+        int size = 0;
+        for (; node != NULL; node = node->next) size++;
+        return size;
+    }
+};
+
+
+/**
+ * This class represents an entire policy-based list. Its functions behave as
+ * the DLinkedList functions of the same name, working from the current
+ * pointer. Destroying the list frees its nodes but not their data.
+ */
+template <typename Alloc = MagazineNodes, typename Lock = NoLock, typename Size = CountSize>
+class PolicyList : private Alloc, private Lock, private Size {
+public:
+    /** The head pointer for the list (points to the first node) */
+    LLNode* head;
+
+    /** The tail pointer for the list (points to the last node) */
+    LLNode* tail;
+
+    /** The current pointer for the list (points to the current node) */
+    LLNode* current;
+
+    PolicyList() : head(NULL), tail(NULL), current(NULL) {}
+
+    /** Start with a copy of the given allocator policy, e.g. PmrNodes(&arena) from pmr_nodes.h */
+    explicit PolicyList(const Alloc& alloc) : Alloc(alloc), head(NULL), tail(NULL), current(NULL) {}
+
+    ~PolicyList() {
+        LLNode* node = head;
+        while (node != NULL) {
+            LLNode* next = node->next;
+            Alloc::deallocate(node);
+            node = next;
+        }
+    }
+
+    PolicyList(const PolicyList&) = delete;
+    PolicyList& operator=(const PolicyList&) = delete;
+
+    /** The allocator policy, for allocators that need setting up */
+    Alloc& allocator() { return *this; }
+
+    /**
+     * release
+     *
+     * Forget every node without giving it back to the allocator, leaving the
+     * list empty. This is for allocators whose memory is released all at
+     * once, like a std::pmr::monotonic_buffer_resource, where walking the
+     * list to free each node would be wasted work.
+     */
+    void release() {
+        Guard guard(this);
+        head = tail = current = NULL;
+        Size::reset();
+    }
+
+    /** Insert as the head. 0 if allocation failed. */
+    int insertHead(void* data) {
+        Guard guard(this);
+        LLNode* node = make(data);
+        if (node == NULL) return 0;
+        link(NULL, node, head);
+        return 1;
+    }
+
+    /** Insert as the tail. 0 if allocation failed. */
+    int insertTail(void* data) {
+        Guard guard(this);
+        LLNode* node = make(data);
+        if (node == NULL) return 0;
+        link(tail, node, NULL);
+        return 1;
+    }
+
+    /** Insert after the current node. 0 if current is NULL or allocation failed. */
+    int insertAfter(void* data) {
+        Guard guard(this);
+        if (current == NULL) return 0;
+        LLNode* node = make(data);
+        if (node == NULL) return 0;
+        link(current, node, current->next);
+        return 1;
+    }
+
+    /** Insert before the current node. 0 if current is NULL or allocation failed. */
+    int insertBefore(void* data) {
+        Guard guard(this);
+        if (current == NULL) return 0;
+        LLNode* node = make(data);
+        if (node == NULL) return 0;
+        link(current->previous, node, current);
+        return 1;
+    }
+
+    /** Remove the current node, free its data and move current backward. Returns
+        the new current data, or NULL. */
+    void* deleteBackward() {
+        void* data;
+        void* now;
+        {
+            Guard guard(this);
+            if (current == NULL) return NULL;
+            data = unlink_current(current->previous);
+            now = data_at(current);
+        }
+        free(data);
+        return now;
+    }
+
+    /** Remove the current node, free its data and move current forward. Returns
+        the new current data, or NULL. */
+    void* deleteForward() {
+        void* data;
+        void* now;
+        {
+            Guard guard(this);
+            if (current == NULL) return NULL;
+            data = unlink_current(current->next);
+            now = data_at(current);
+        }
+        free(data);
+        return now;
+    }
+
+    /** Remove the current node and move current backward. Returns its data, or NULL. */
+    void* removeBackward() {
+        Guard guard(this);
+        if (current == NULL) return NULL;
+        return unlink_current(current->previous);
+    }
+
+    /** Remove the current node and move current forward. Returns its data, or NULL. */
+    void* removeForward() {
+        Guard guard(this);
+        if (current == NULL) return NULL;
+        return unlink_current(current->next);
+    }
+
+    /** Move current to the head and return its data, or NULL if empty */
+    void* getHead() {
+        Guard guard(this);
+        current = head;
+        return data_at(current);
+    }
+
+    /** Move current to the tail and return its data, or NULL if empty */
+    void* getTail() {
+        Guard guard(this);
+        current = tail;
+        return data_at(current);
+    }
+
+    /** Return the current data, or NULL if current == NULL */
+    void* getCurrent() {
+        Guard guard(this);
+        return data_at(current);
+    }
+
+    /** Move current forward and return its data, or NULL past the tail */
+    void* getNext() {
+        Guard guard(this);
+        if (current == NULL) return NULL;
+        current = current->next;
+        return data_at(current);
+    }
+
+    /** Move current backward and return its data, or NULL past the head */
+    void* getPrevious() {
+        Guard guard(this);
+        if (current == NULL) return NULL;
+        current = current->previous;
+        return data_at(current);
+    }
+
+    /** Return the number of nodes. O(n) under NoSize. */
+    int getSize() {
+        Guard guard(this);
+        return Size::count(head);
+    }
+
+private:
+    // Holds the lock policy for the rest of a call
+    struct Guard {
+        PolicyList* owner;
+        explicit Guard(PolicyList* l) : owner(l) { owner->Lock::lock(); }
+        ~Guard() { owner->Lock::unlock(); }
+    };
+
+    static void* data_at(LLNode* node) { return node != NULL ? node->data : NULL; }
+
+    LLNode* make(void* data) {
+        LLNode* node = Alloc::allocate();
+        if (node != NULL) node->data = data;
+        return node;
+    }
+
+    // Link a node in between two neighbors, either of which may be NULL
+    void link(LLNode* previous, LLNode* node, LLNode* next) {
+        node->previous = previous;
+        node->next = next;
+        if (previous != NULL) previous->next = node;
+        else head = node;
+        if (next != NULL) next->previous = node;
+        else tail = node;
+        Size::added();
+    }
+
+    // Unlink a node, free it and return its data. The current pointer has
+    // already moved off it.
+    void* unlink(LLNode* node) {
+        if (node->previous != NULL) node->previous->next = node->next;
+        else head = node->next;
+        if (node->next != NULL) node->next->previous = node->previous;
+        else tail = node->previous;
+        Size::removed();
+        void* data = node->data;
+        Alloc::deallocate(node);
+        return data;
+    }
+
+    // Move current to one of its neighbors, then unlink the node it was on and
+    // return its data. The caller holds the guard and has checked current.
+    void* unlink_current(LLNode* neighbor) {
+        LLNode* node = current;
+        current = neighbor;
+        return unlink(node);
+    }
+};
+#endif
@@ -0,0 +1,134 @@
+// Every combination of the policy list's allocator, locking and size
+// policies against DLinkedList, on insert/remove churn and a full walk, then
+// request-scoped lists drawing nodes from std::pmr resources
+//
+// Usage: ./policy_list_bench [rounds] [nodes per round]
+//
+// Each round appends a batch of nodes, walks them, then removes them from
+// the head. One thread runs everything, so MutexLock rows show the cost of an
+// uncontended lock and unlock around each call.
+//
+// A request-scoped round builds a list, walks it and throws it away. With a
+// monotonic buffer the list is released instead of destroyed, and the buffer
+// is reset for the next round.
+
+#include <memory_resource>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "pmr_nodes.h"
+#include "list_policies.h"
+#include "policy_list.h"
+
+static long rounds;
+static int batch;
+static uintptr_t sink;
+
+static void run_dlinkedlist(void)
+{
+	DLinkedList* list = create_dlinkedlist();
+	double begin = benchSeconds();
+	for (long r = 0; r < rounds; r++) {
+		for (int i = 0; i < batch; i++) insertTail(list, list);
+		for (void* d = getHead(list); d != NULL; d = getNext(list)) sink += (uintptr_t) d;
+		getHead(list);
+		for (int i = 0; i < batch; i++) removeForward(list);
+	}
+	benchReport("DLinkedList", (double) rounds * batch, benchSeconds() - begin);
+	destroyList(list);
+}
+
+template <typename L>
+static void run(const char* name)
+{
+	L* list = new L;
+	double begin = benchSeconds();
+	for (long r = 0; r < rounds; r++) {
+		for (int i = 0; i < batch; i++) list->insertTail(list);
+		for (void* d = list->getHead(); d != NULL; d = list->getNext()) sink += (uintptr_t) d;
+		list->getHead();
+		for (int i = 0; i < batch; i++) list->removeForward();
+	}
+	benchReport(name, (double) rounds * batch, benchSeconds() - begin);
+	delete list;
+}
+
+// Run each size policy for one allocator and lock
+template <typename Alloc, typename Lock>
+static void run_sizes(const char* alloc, const char* lock)
+{
+	char name[64];
+	snprintf(name, sizeof(name), "%-8s %-9s CountSize", alloc, lock);
+	run<PolicyList<Alloc, Lock, CountSize> >(name);
+	snprintf(name, sizeof(name), "%-8s %-9s NoSize", alloc, lock);
+	run<PolicyList<Alloc, Lock, NoSize> >(name);
+}
+
+template <typename Alloc>
+static void run_locks(const char* alloc)
+{
+	run_sizes<Alloc, NoLock>(alloc, "NoLock");
+	run_sizes<Alloc, MutexLock>(alloc, "MutexLock");
+}
+
+// Fill and walk one request's list; the caller decides how it goes away
+template <typename L>
+static void scoped_round(L* list)
+{
+	for (int i = 0; i < batch; i++) list->insertTail(list);
+	for (void* d = list->getHead(); d != NULL; d = list->getNext()) sink += (uintptr_t) d;
+}
+
+static void run_scoped(void)
+{
+	double ops = (double) rounds * batch;
+	double begin = benchSeconds();
+	for (long r = 0; r < rounds; r++) {
+		PolicyList<MallocNodes> list;
+		scoped_round(&list);
+	}
+	benchReport("scoped Malloc", ops, benchSeconds() - begin);
+
+	begin = benchSeconds();
+	for (long r = 0; r < rounds; r++) {
+		PolicyList<MagazineNodes> list;
+		scoped_round(&list);
+	}
+	benchReport("scoped Magazine", ops, benchSeconds() - begin);
+
+	std::pmr::unsynchronized_pool_resource pool;
+	begin = benchSeconds();
+	for (long r = 0; r < rounds; r++) {
+		PolicyList<PmrNodes> list((PmrNodes(&pool)));
+		scoped_round(&list);
+	}
+	benchReport("scoped pmr pool", ops, benchSeconds() - begin);
+
+	// The buffer is big enough that the arena never goes upstream
+	size_t bytes = (size_t) batch * sizeof(LLNode) * 2;
+	char* buffer = (char*) malloc(bytes);
+	std::pmr::monotonic_buffer_resource arena(buffer, bytes, std::pmr::null_memory_resource());
+	begin = benchSeconds();
+	for (long r = 0; r < rounds; r++) {
+		PolicyList<PmrNodes> list((PmrNodes(&arena)));
+		scoped_round(&list);
+		list.release();
+		arena.release();
+	}
+	benchReport("scoped pmr monotonic, released", ops, benchSeconds() - begin);
+	free(buffer);
+}
+
+int main(int argc, char** argv)
+{
+	rounds = argc > 1 ? atol(argv[1]) : 200000;
+	batch = argc > 2 ? atoi(argv[2]) : 16;
+
+	run_dlinkedlist();
+	run_locks<MagazineNodes>("Magazine");
+	run_locks<MallocNodes>("Malloc");
+	run_locks<PoolNodes>("Pool");
+	run_locks<PmrNodes>("Pmr");
+	run_scoped();
+	return sink == 0;
+}
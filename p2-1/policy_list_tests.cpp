@@ -0,0 +1,156 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "pmr_nodes.h"
+#include "list_policies.h"
+#include "policy_list.h"
+#include "static_list.h"
+#include "gtest/gtest.h"
+
+
+#define THREADS 4
+#define ITEMS_PER_THREAD 5000
+
+// Unused policies take no space
+static_assert(sizeof(PolicyList<MagazineNodes, NoLock, NoSize>) == 3 * sizeof(LLNode*),
+		"empty policies should not add to the list");
+static_assert(sizeof(PolicyList<MallocNodes, NoLock, CountSize>) <= 4 * sizeof(LLNode*),
+		"the size policy should add one counter");
+
+// Counts what passes through it to new and delete
+class CountingResource : public std::pmr::memory_resource {
+public:
+	int allocations = 0, deallocations = 0;
+private:
+	void* do_allocate(size_t bytes, size_t align) override {
+		allocations++;
+		return std::pmr::new_delete_resource()->allocate(bytes, align);
+	}
+	void do_deallocate(void* p, size_t bytes, size_t align) override {
+		deallocations++;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+};
+
+template <typename L>
+class PolicyListTest : public ::testing::Test {};
+
+typedef ::testing::Types<
+		PolicyList<MagazineNodes, NoLock, CountSize>,
+		PolicyList<MagazineNodes, MutexLock, NoSize>,
+		PolicyList<MallocNodes, NoLock, NoSize>,
+		PolicyList<MallocNodes, MutexLock, CountSize>,
+		PolicyList<PoolNodes, NoLock, CountSize>,
+		PolicyList<PoolNodes, MutexLock, NoSize>,
+		PolicyList<PmrNodes, NoLock, CountSize>,
+		StaticDLinkedList<100> > Combinations;
+TYPED_TEST_CASE(PolicyListTest, Combinations);
+
+// Appends its own run of numbers to a shared list
+template <typename L>
+static void* writer_thread(void* arg)
+{
+	L* list = (L*) arg;
+	for (uintptr_t i = 1; i <= ITEMS_PER_THREAD; i++) list->insertTail((void*) i);
+	return NULL;
+}
+
+
+TYPED_TEST(PolicyListTest, CursorMatchesDLinkedList)
+{
+	TypeParam list;
+	EXPECT_EQ(NULL, list.getHead());
+	EXPECT_EQ(0, list.insertAfter((void*) 9));
+	EXPECT_EQ(1, list.insertTail((void*) 2));
+	EXPECT_EQ(1, list.insertHead((void*) 1));
+	EXPECT_EQ(1, list.insertTail((void*) 4));
+	list.getTail();
+	EXPECT_EQ(1, list.insertBefore((void*) 3));
+	EXPECT_EQ(1, list.insertAfter((void*) 5));
+	EXPECT_EQ((void*) 4, list.getCurrent());
+	EXPECT_EQ(5, list.getSize());
+
+	// Walk both ways
+	uintptr_t expected = 1;
+	for (void* d = list.getHead(); d != NULL; d = list.getNext()) EXPECT_EQ(expected++, (uintptr_t) d);
+	for (void* d = list.getTail(); d != NULL; d = list.getPrevious()) EXPECT_EQ(--expected, (uintptr_t) d);
+
+	// Remove from the middle in each direction, then both ends
+	list.getHead(); list.getNext();
+	EXPECT_EQ((void*) 2, list.removeForward());
+	EXPECT_EQ((void*) 3, list.removeBackward());
+	EXPECT_EQ((void*) 1, list.getCurrent());
+	EXPECT_EQ((void*) 1, list.removeBackward());
+	EXPECT_EQ(NULL, list.removeBackward());
+	list.getTail();
+	EXPECT_EQ((void*) 5, list.removeForward());
+	EXPECT_EQ(1, list.getSize());
+	EXPECT_EQ(list.head, list.tail);
+	EXPECT_EQ((void*) 4, list.getHead());
+
+	// deleteForward frees the data, as with DLinkedList
+	EXPECT_EQ(1, list.insertHead(malloc(16)));
+	list.getHead();
+	EXPECT_EQ((void*) 4, list.deleteForward());
+	EXPECT_EQ(1, list.getSize());
+
+	// Freed nodes are reused
+	list.removeForward();
+	for (uintptr_t i = 0; i < 100; i++) list.insertHead((void*) i);
+	EXPECT_EQ(100, list.getSize());
+}
+
+TEST(PolicyList, MutexLockSharesAList)
+{
+	typedef PolicyList<MagazineNodes, MutexLock, CountSize> Locked;
+	Locked list;
+	pthread_t threads[THREADS];
+	for (int i = 0; i < THREADS; i++)
+		ASSERT_EQ(0, pthread_create(&threads[i], NULL, writer_thread<Locked>, &list));
+	for (int i = 0; i < THREADS; i++) pthread_join(threads[i], NULL);
+	EXPECT_EQ(THREADS * ITEMS_PER_THREAD, list.getSize());
+
+	uintptr_t sum = 0;
+	for (void* d = list.getHead(); d != NULL; d = list.getNext()) sum += (uintptr_t) d;
+	EXPECT_EQ((uintptr_t) THREADS * ITEMS_PER_THREAD * (ITEMS_PER_THREAD + 1) / 2, sum);
+}
+
+TEST(PolicyList, PmrNodesUseTheResource)
+{
+	CountingResource counting;
+	{
+		PolicyList<PmrNodes> list((PmrNodes(&counting)));
+		for (uintptr_t i = 1; i <= 10; i++) list.insertTail((void*) i);
+		list.getHead();
+		list.removeForward();
+		EXPECT_EQ(10, counting.allocations);
+		EXPECT_EQ(1, counting.deallocations);
+	}
+	EXPECT_EQ(10, counting.deallocations);
+}
+
+TEST(PolicyList, MonotonicBufferSkipsDestruction)
+{
+	// Every node fits in the buffer, and release drops them all at once
+	alignas(LLNode) char buffer[64 * sizeof(LLNode)];
+	CountingResource upstream;
+	std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), &upstream);
+	PolicyList<PmrNodes> list((PmrNodes(&arena)));
+	for (uintptr_t i = 1; i <= 64; i++) list.insertHead((void*) i);
+	EXPECT_EQ(0, upstream.allocations);
+	EXPECT_GE((char*) list.head, buffer);
+	EXPECT_LT((char*) list.head, buffer + sizeof(buffer));
+
+	list.release();
+	EXPECT_EQ(0, list.getSize());
+	EXPECT_EQ(NULL, list.getHead());
+	arena.release();
+
+	// The list can be refilled from the same resource
+	EXPECT_EQ(1, list.insertTail((void*) 1));
+	EXPECT_EQ(1, list.getSize());
+	list.release();
+}
@@ -0,0 +1,162 @@
+// A read-mostly doublely linked list in the style of read-copy-update
+
+#include <sched.h>
+#include <stdlib.h>
+#include "rcu_list.h"
+
+// Link an unpublished node between two neighbors. Its own links are filled
+// in first, so the release store makes a complete node visible to readers.
+static void publish_node(DLinkedList* list, LLNode* previous, LLNode* next, LLNode* node) {
+	node->previous = previous;
+	node->next = next;
+	if (next != NULL) next->previous = node;
+	else list->tail = node;
+	if (previous != NULL) __atomic_store_n(&previous->next, node, __ATOMIC_RELEASE);
+	else __atomic_store_n(&list->head, node, __ATOMIC_RELEASE);
+	__atomic_store_n(&list->size, list->size + 1, __ATOMIC_RELAXED);
+}
+
+// Unlink a node and retire it. Its next pointer is left alone so a reader
+// standing on it can still walk back into the list.
+static void unpublish_node(RCUList* rl, LLNode* node) {
+	DLinkedList* list = rl->list;
+	LLNode* previous = node->previous;
+	LLNode* next = node->next;
+	if (previous != NULL) __atomic_store_n(&previous->next, next, __ATOMIC_RELEASE);
+	else __atomic_store_n(&list->head, next, __ATOMIC_RELEASE);
+	if (next != NULL) next->previous = previous;
+	else list->tail = previous;
+	__atomic_store_n(&list->size, list->size - 1, __ATOMIC_RELAXED);
+	epochRetire(rl->writer, node);
+}
+
+RCUList* create_rculist(void) {
+	// Create space for the list and its parts
+	RCUList* rl = (RCUList *) malloc(sizeof(RCUList));
+	if (rl == NULL) return NULL;
+	rl->list = create_dlinkedlist();
+	rl->domain = create_epochdomain(NULL);
+	if (rl->list == NULL || rl->domain == NULL) {
+		if (rl->list != NULL) destroyList(rl->list);
+		if (rl->domain != NULL) destroyEpochDomain(rl->domain);
+		free(rl);
+		return NULL;
+	}
+	pthread_mutex_init(&rl->writeLock, NULL);
+	rl->writer = NULL;
+	return rl;
+}
+
+void destroyRCUList(RCUList* rl) {
+	destroyList(rl->list);
+	destroyEpochDomain(rl->domain);
+	pthread_mutex_destroy(&rl->writeLock);
+	free(rl);
+}
+
+EpochThread* rcuRegister(RCUList* rl) {
+	return epochRegister(rl->domain);
+}
+
+void rcuUnregister(EpochThread* thread) {
+	epochUnregister(thread);
+}
+
+void rcuReadBegin(RCUList* rl, EpochThread* thread, RCUReader* reader) {
+	epochEnter(thread);
+	reader->owner = rl;
+	reader->thread = thread;
+	reader->node = NULL;
+}
+
+void* rcuReadHead(RCUReader* reader) {
+	reader->node = __atomic_load_n(&reader->owner->list->head, __ATOMIC_ACQUIRE);
+	return reader->node != NULL ? reader->node->data : NULL;
+}
+
+void* rcuReadNext(RCUReader* reader) {
+	if (reader->node == NULL) return NULL;
+	reader->node = __atomic_load_n(&reader->node->next, __ATOMIC_ACQUIRE);
+	return reader->node != NULL ? reader->node->data : NULL;
+}
+
+void rcuReadEnd(RCUReader* reader) {
+	reader->node = NULL;
+	epochExit(reader->thread);
+}
+
+int rcuGetSize(RCUList* rl) {
+	return __atomic_load_n(&rl->list->size, __ATOMIC_RELAXED);
+}
+
+void rcuWriteBegin(RCUList* rl, EpochThread* thread) {
+	pthread_mutex_lock(&rl->writeLock);
+	rl->writer = thread;
+}
+
+void rcuWriteEnd(RCUList* rl) {
+	rl->writer = NULL;
+	pthread_mutex_unlock(&rl->writeLock);
+}
+
+int rcuInsertHead(RCUList* rl, void* data) {
+	LLNode* node = create_llnode(data);
+	if (node == NULL) return 0;
+	publish_node(rl->list, NULL, rl->list->head, node);
+	return 1;
+}
+
+int rcuInsertTail(RCUList* rl, void* data) {
+	LLNode* node = create_llnode(data);
+	if (node == NULL) return 0;
+	publish_node(rl->list, rl->list->tail, NULL, node);
+	return 1;
+}
+
+int rcuInsertAfter(RCUList* rl, void* data) {
+	// Only insert if the current node is non-null
+	LLNode* current = rl->list->current;
+	if (current == NULL) return 0;
+	LLNode* node = create_llnode(data);
+	if (node == NULL) return 0;
+	publish_node(rl->list, current, current->next, node);
+	return 1;
+}
+
+int rcuInsertBefore(RCUList* rl, void* data) {
+	// Only insert if the current node is non-null
+	LLNode* current = rl->list->current;
+	if (current == NULL) return 0;
+	LLNode* node = create_llnode(data);
+	if (node == NULL) return 0;
+	publish_node(rl->list, current->previous, current, node);
+	return 1;
+}
+
+void* rcuRemoveForward(RCUList* rl) {
+	// Only remove the current node if it is non-null
+	LLNode* node = rl->list->current;
+	if (node == NULL) return NULL;
+
+	// Move the current pointer forward before the node is retired
+	void* data = node->data;
+	rl->list->current = node->next;
+	unpublish_node(rl, node);
+	return data;
+}
+
+void* rcuRemoveBackward(RCUList* rl) {
+	// Only remove the current node if it is non-null
+	LLNode* node = rl->list->current;
+	if (node == NULL) return NULL;
+
+	// Move the current pointer backward before the node is retired
+	void* data = node->data;
+	rl->list->current = node->previous;
+	unpublish_node(rl, node);
+	return data;
+}
+
+void rcuSynchronize(EpochThread* thread) {
+	while (!epochSynchronize(thread)) sched_yield();
+}
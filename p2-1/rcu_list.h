@@ -0,0 +1,246 @@
+/** @file rcu_list.h */
+#ifndef RCULIST_H
+#define RCULIST_H
+
+#include <pthread.h>
+#include "doublely_linked_list.h"
+#include "epoch.h"
+
+
+/********************************************
+ * RCU list library functions               *
+ * A read-mostly doublely linked list.      *
+ * Readers walk forward with plain loads    *
+ * and never lock or do an atomic read-     *
+ * modify-write. Writers take a mutex,      *
+ * publish changes with release stores and *
+ * retire removed nodes to an epoch domain. *
+ ********************************************/
+
+
+/**
+ * This structure represents a read-mostly list. Readers only follow head and
+ * next pointers; previous, tail and current belong to the writer.
+ */
+typedef struct rculist_t {
+    /** The underlying list. Its index must stay disabled. */
+    DLinkedList* list;
+
+    /** Held by the one writer at a time */
+    pthread_mutex_t writeLock;
+
+    /** Holds removed nodes until every reader that might see them is done */
+    EpochDomain* domain;
+
+    /** The writer's record while a write session is open */
+    EpochThread* writer;
+} RCUList;
+
+/**
+ * This structure represents one reader's position in the list. It is only
+ * valid between rcuReadBegin and rcuReadEnd.
+ */
+typedef struct rcureader_t {
+    /** The list being read */
+    RCUList* owner;
+
+    /** The reader's record */
+    EpochThread* thread;
+
+    /** The node the reader is at. NULL if it is off the list. */
+    LLNode* node;
+} RCUReader;
+
+
+/**
+ * create_rculist
+ *
+ * Creates an empty RCU list by allocating memory for it on the heap.
+ *
+ * @return A pointer to an empty list, or NULL if allocation failed
+ */
+RCUList* create_rculist(void);
+
+/**
+ * destroyRCUList
+ *
+ * Destroy the list. As with destroyList, nodes and data are all freed. Every
+ * thread must have unregistered first.
+ *
+ * @param rl A pointer to the list
+ */
+void destroyRCUList(RCUList* rl);
+
+/**
+ * rcuRegister
+ *
+ * Register the calling thread with the list, as a reader, a writer or both.
+ *
+ * @param rl A pointer to the list
+ * @return the thread's record, or NULL if EPOCH_MAX_THREADS are already registered
+ */
+EpochThread* rcuRegister(RCUList* rl);
+
+/**
+ * rcuUnregister
+ *
+ * Release the calling thread's record.
+ *
+ * @param thread The thread's record
+ */
+void rcuUnregister(EpochThread* thread);
+
+/**
+ * rcuReadBegin
+ *
+ * Start a read-side critical section. Nodes seen inside it stay valid until
+ * rcuReadEnd, even if a writer removes them. The reader starts off the list.
+ *
+ * @param rl A pointer to the list
+ * @param thread The calling thread's record
+ * @param reader A pointer to the calling thread's reader
+ */
+void rcuReadBegin(RCUList* rl, EpochThread* thread, RCUReader* reader);
+
+/**
+ * rcuReadHead
+ *
+ * Move the reader to the head of the list.
+ *
+ * @param reader A pointer to the reader
+ * @return the head's data, or NULL if the list is empty
+ */
+void* rcuReadHead(RCUReader* reader);
+
+/**
+ * rcuReadNext
+ *
+ * Move the reader forward one node. A node removed while the reader was on
+ * it still leads back into the list.
+ *
+ * @param reader A pointer to the reader
+ * @return the next node's data, or NULL at the end of the list
+ */
+void* rcuReadNext(RCUReader* reader);
+
+/**
+ * rcuReadEnd
+ *
+ * End the read-side critical section.
+ *
+ * @param reader A pointer to the reader
+ */
+void rcuReadEnd(RCUReader* reader);
+
+/**
+ * rcuGetSize
+ *
+ * Return the size of the list without locking. It may be stale by the time
+ * it is used.
+ *
+ * @param rl A pointer to the list
+ * @return the size
+ */
+int rcuGetSize(RCUList* rl);
+
+/**
+ * rcuWriteBegin
+ *
+ * Take the write lock. Inside a write session the writer moves around with
+ * the usual getHead, getNext, getPrevious and getTail on rl->list, and edits
+ * with the rcu functions below.
+ *
+ * @param rl A pointer to the list
+ * @param thread The calling thread's record
+ */
+void rcuWriteBegin(RCUList* rl, EpochThread* thread);
+
+/**
+ * rcuWriteEnd
+ *
+ * Release the write lock.
+ *
+ * @param rl A pointer to the list
+ */
+void rcuWriteEnd(RCUList* rl);
+
+/**
+ * rcuInsertHead
+ *
+ * Publish a new node at the head of the list. Must be inside a write session.
+ *
+ * @param rl A pointer to the list
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted, 0 if no node could be allocated
+ */
+int rcuInsertHead(RCUList* rl, void* data);
+
+/**
+ * rcuInsertTail
+ *
+ * Publish a new node at the tail of the list. Must be inside a write session.
+ *
+ * @param rl A pointer to the list
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted, 0 if no node could be allocated
+ */
+int rcuInsertTail(RCUList* rl, void* data);
+
+/**
+ * rcuInsertAfter
+ *
+ * Publish a new node after the current node, as insertAfter does.
+ *
+ * @param rl A pointer to the list
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted
+ *         0 if the current pointer is NULL or no node could be allocated
+ */
+int rcuInsertAfter(RCUList* rl, void* data);
+
+/**
+ * rcuInsertBefore
+ *
+ * Publish a new node before the current node, as insertBefore does.
+ *
+ * @param rl A pointer to the list
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted
+ *         0 if the current pointer is NULL or no node could be allocated
+ */
+int rcuInsertBefore(RCUList* rl, void* data);
+
+/**
+ * rcuRemoveForward
+ *
+ * Unlink the current node and move the current pointer forward, as
+ * removeForward does. The node is freed after a grace period. Readers may
+ * still hold the data, so it must not be freed before rcuSynchronize.
+ *
+ * @param rl A pointer to the list
+ * @return the data of the removed node, or NULL if the current pointer is NULL
+ */
+void* rcuRemoveForward(RCUList* rl);
+
+/**
+ * rcuRemoveBackward
+ *
+ * Unlink the current node and move the current pointer backward, as
+ * removeBackward does. The node is freed after a grace period.
+ *
+ * @param rl A pointer to the list
+ * @return the data of the removed node, or NULL if the current pointer is NULL
+ */
+void* rcuRemoveBackward(RCUList* rl);
+
+/**
+ * rcuSynchronize
+ *
+ * Wait until every reader that was inside a critical section has left it,
+ * freeing the nodes this thread removed. Must not be called inside a read
+ * session.
+ *
+ * @param thread The calling thread's record
+ */
+void rcuSynchronize(EpochThread* thread);
+#endif
@@ -0,0 +1,117 @@
+// Read-mostly traffic on the RCU list against the reader-writer locked list,
+// from 1 to 32 threads
+//
+// Usage: ./rcu_list_bench [operations per thread] [writes per ten thousand]
+//
+// A read walks the first WALK nodes. A write appends one node and removes the
+// head, so the list length stays constant.
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "concurrent_list.h"
+#include "rcu_list.h"
+
+#define PREFILL 1000
+#define WALK 32
+
+struct Workload {
+	RCUList* rl;
+	ConcurrentList* cl;
+	long ops;
+	int writeRate;
+	int sink;
+};
+
+static void* rcu_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	uint64_t rng = 0x9e3779b97f4a7c15ULL * (t->index + 1);
+	EpochThread* thread = rcuRegister(w->rl);
+	int sink = 0;
+	for (long i = 0; i < w->ops; i++) {
+		if ((int) (benchRandom(&rng) % 10000) < w->writeRate) {
+			rcuWriteBegin(w->rl, thread);
+			rcuInsertTail(w->rl, w);
+			getHead(w->rl->list);
+			rcuRemoveForward(w->rl);
+			rcuWriteEnd(w->rl);
+			continue;
+		}
+		RCUReader reader;
+		rcuReadBegin(w->rl, thread, &reader);
+		void* d = rcuReadHead(&reader);
+		for (int n = 0; n < WALK && d != NULL; n++)
+			d = rcuReadNext(&reader);
+		sink += d != NULL;
+		rcuReadEnd(&reader);
+	}
+	rcuUnregister(thread);
+	__atomic_fetch_add(&w->sink, sink, __ATOMIC_RELAXED);
+	return NULL;
+}
+
+static void* rwlock_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	uint64_t rng = 0x9e3779b97f4a7c15ULL * (t->index + 1);
+	int sink = 0;
+	for (long i = 0; i < w->ops; i++) {
+		ListCursor cursor;
+		if ((int) (benchRandom(&rng) % 10000) < w->writeRate) {
+			beginWrite(w->cl, &cursor);
+			cursorTail(&cursor);
+			cursorInsertAfter(&cursor, w);
+			cursorHead(&cursor);
+			cursorRemoveForward(&cursor);
+			endAccess(&cursor);
+			continue;
+		}
+		beginRead(w->cl, &cursor);
+		void* d = cursorHead(&cursor);
+		for (int n = 0; n < WALK && d != NULL; n++)
+			d = cursorNext(&cursor);
+		sink += d != NULL;
+		endAccess(&cursor);
+	}
+	__atomic_fetch_add(&w->sink, sink, __ATOMIC_RELAXED);
+	return NULL;
+}
+
+int main(int argc, char** argv)
+{
+	Workload w;
+	w.ops = argc > 1 ? atol(argv[1]) : 200000;
+	w.writeRate = argc > 2 ? atoi(argv[2]) : 10;
+	w.sink = 0;
+
+	for (int threads = 1; threads <= 32; threads *= 2) {
+		char name[64];
+		w.rl = create_rculist();
+		w.cl = create_concurrentlist();
+		EpochThread* thread = rcuRegister(w.rl);
+		rcuWriteBegin(w.rl, thread);
+		for (int i = 0; i < PREFILL; i++) {
+			rcuInsertTail(w.rl, &w);
+			concurrentInsertTail(w.cl, &w);
+		}
+		rcuWriteEnd(w.rl);
+		rcuUnregister(thread);
+
+		double seconds = benchRunThreads(threads, rcu_body, &w);
+		snprintf(name, sizeof(name), "rcu     threads=%2d writes=%d/10000", threads, w.writeRate);
+		benchReport(name, (double) w.ops * threads, seconds);
+
+		seconds = benchRunThreads(threads, rwlock_body, &w);
+		snprintf(name, sizeof(name), "rwlock  threads=%2d writes=%d/10000", threads, w.writeRate);
+		benchReport(name, (double) w.ops * threads, seconds);
+
+		// Every thread has unregistered, so the list can be emptied directly
+		benchDrain(w.rl->list);
+		benchDrain(w.cl->list);
+		destroyRCUList(w.rl);
+		destroyConcurrentList(w.cl);
+	}
+
+	return w.sink == -1;
+}
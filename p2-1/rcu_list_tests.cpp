@@ -0,0 +1,179 @@
+#include <pthread.h>
+#include <stdint.h>
+#include "rcu_list.h"
+#include "gtest/gtest.h"
+
+
+#define READERS 3
+#define WRITES 20000
+#define LENGTH 64
+
+struct ReaderArgs {
+	RCUList* rl;
+	int* done;
+	long walks;
+	int failures;
+};
+
+// Walks the list over and over, checking the keys always increase
+static void* reader_thread(void* arg)
+{
+	ReaderArgs* args = (ReaderArgs*) arg;
+	EpochThread* thread = rcuRegister(args->rl);
+	do {
+		RCUReader reader;
+		rcuReadBegin(args->rl, thread, &reader);
+		uintptr_t last = 0;
+		for (void* d = rcuReadHead(&reader); d != NULL; d = rcuReadNext(&reader)) {
+			if ((uintptr_t) d <= last) args->failures++;
+			last = (uintptr_t) d;
+		}
+		rcuReadEnd(&reader);
+		args->walks++;
+	} while (!__atomic_load_n(args->done, __ATOMIC_ACQUIRE));
+	rcuUnregister(thread);
+	return NULL;
+}
+
+// Remove every node inside a write session, leaving the borrowed data alone
+static void drain(RCUList* rl, EpochThread* thread)
+{
+	rcuWriteBegin(rl, thread);
+	getHead(rl->list);
+	while (getCurrent(rl->list) != NULL) rcuRemoveForward(rl);
+	rcuWriteEnd(rl);
+	rcuSynchronize(thread);
+}
+
+
+TEST(RCUList, WriterEdits)
+{
+	RCUList* rl = create_rculist();
+	ASSERT_TRUE(rl != NULL);
+	EpochThread* thread = rcuRegister(rl);
+
+	// Build 1 2 3 4 5 out of order
+	rcuWriteBegin(rl, thread);
+	rcuInsertTail(rl, (void*) 3);
+	rcuInsertHead(rl, (void*) 1);
+	rcuInsertTail(rl, (void*) 5);
+	getHead(rl->list);
+	EXPECT_EQ(1, rcuInsertAfter(rl, (void*) 2));
+	getTail(rl->list);
+	EXPECT_EQ(1, rcuInsertBefore(rl, (void*) 4));
+	rcuWriteEnd(rl);
+	EXPECT_EQ(5, rcuGetSize(rl));
+
+	RCUReader reader;
+	rcuReadBegin(rl, thread, &reader);
+	uintptr_t expected = 1;
+	for (void* d = rcuReadHead(&reader); d != NULL; d = rcuReadNext(&reader))
+		EXPECT_EQ((void*) expected++, d);
+	EXPECT_EQ(6u, expected);
+	rcuReadEnd(&reader);
+
+	// Removing moves the current pointer the same way the core list does
+	rcuWriteBegin(rl, thread);
+	getHead(rl->list);
+	getNext(rl->list);
+	EXPECT_EQ((void*) 2, rcuRemoveForward(rl));
+	EXPECT_EQ((void*) 3, getCurrent(rl->list));
+	EXPECT_EQ((void*) 3, rcuRemoveBackward(rl));
+	EXPECT_EQ((void*) 1, getCurrent(rl->list));
+	EXPECT_EQ((void*) 4, getNext(rl->list));
+	EXPECT_EQ((void*) 1, getPrevious(rl->list));
+	getTail(rl->list);
+	EXPECT_EQ((void*) 5, rcuRemoveForward(rl));
+	EXPECT_EQ(NULL, getCurrent(rl->list));
+	EXPECT_EQ(0, rcuInsertAfter(rl, (void*) 6));
+	EXPECT_EQ(NULL, rcuRemoveForward(rl));
+	EXPECT_EQ((void*) 4, getTail(rl->list));
+	rcuWriteEnd(rl);
+	EXPECT_EQ(2, rcuGetSize(rl));
+
+	drain(rl, thread);
+	rcuUnregister(thread);
+	destroyRCUList(rl);
+}
+
+TEST(RCUList, RemovedNodeOutlivesReader)
+{
+	RCUList* rl = create_rculist();
+	EpochThread* readerThread = rcuRegister(rl);
+	EpochThread* writerThread = rcuRegister(rl);
+	rcuWriteBegin(rl, writerThread);
+	for (uintptr_t i = 1; i <= 3; i++) rcuInsertTail(rl, (void*) i);
+	rcuWriteEnd(rl);
+
+	// The reader stands on the middle node
+	RCUReader reader;
+	rcuReadBegin(rl, readerThread, &reader);
+	rcuReadHead(&reader);
+	EXPECT_EQ((void*) 2, rcuReadNext(&reader));
+
+	// The writer removes it; the node is held back while the reader is inside
+	rcuWriteBegin(rl, writerThread);
+	getHead(rl->list);
+	getNext(rl->list);
+	EXPECT_EQ((void*) 2, rcuRemoveForward(rl));
+	rcuWriteEnd(rl);
+	EXPECT_EQ(0, epochSynchronize(writerThread));
+
+	// The reader can still leave the removed node the way it came
+	EXPECT_EQ((void*) 3, rcuReadNext(&reader));
+	rcuReadEnd(&reader);
+	EXPECT_EQ(1, epochSynchronize(writerThread));
+	EXPECT_EQ(2, rcuGetSize(rl));
+
+	drain(rl, writerThread);
+	rcuUnregister(readerThread);
+	rcuUnregister(writerThread);
+	destroyRCUList(rl);
+}
+
+TEST(RCUList, ReadersDuringWrites)
+{
+	RCUList* rl = create_rculist();
+	EpochThread* writer = rcuRegister(rl);
+	rcuWriteBegin(rl, writer);
+	for (uintptr_t i = 1; i <= LENGTH; i++) rcuInsertTail(rl, (void*) i);
+	rcuWriteEnd(rl);
+
+	int done = 0;
+	pthread_t threads[READERS];
+	ReaderArgs args[READERS];
+	for (int t = 0; t < READERS; t++) {
+		args[t].rl = rl;
+		args[t].done = &done;
+		args[t].walks = 0;
+		args[t].failures = 0;
+		pthread_create(&threads[t], NULL, reader_thread, &args[t]);
+	}
+
+	// Keep the list sorted: drop the head, append a larger key, and
+	// sometimes drop one from the middle
+	for (uintptr_t i = LENGTH + 1; i <= LENGTH + WRITES; i++) {
+		rcuWriteBegin(rl, writer);
+		getHead(rl->list);
+		rcuRemoveForward(rl);
+		rcuInsertTail(rl, (void*) i);
+		if (i % 4 == 0) {
+			getNext(rl->list);
+			rcuRemoveBackward(rl);
+			rcuInsertTail(rl, (void*) ++i);
+		}
+		rcuWriteEnd(rl);
+	}
+	__atomic_store_n(&done, 1, __ATOMIC_RELEASE);
+
+	for (int t = 0; t < READERS; t++) {
+		pthread_join(threads[t], NULL);
+		EXPECT_EQ(0, args[t].failures);
+		EXPECT_LT(0, args[t].walks);
+	}
+	EXPECT_EQ(LENGTH, rcuGetSize(rl));
+
+	drain(rl, writer);
+	rcuUnregister(writer);
+	destroyRCUList(rl);
+}
@@ -0,0 +1,93 @@
+// A list split into per-thread DLinkedList stripes
+
+#include <stdlib.h>
+#include "node_index.h"
+#include "sharded_list.h"
+
+// Hands out stripe numbers to threads round robin. One counter serves every
+// list, so two threads never draw the same number.
+static unsigned next_stripe;
+
+// The stripe number this thread drew, plus one so that 0 means none yet. It
+// is used in every sharded list, masked to that list's stripe count.
+static __thread unsigned thread_stripe;
+
+// Append to one stripe under its lock and republish its size
+static int insert_stripe(ShardStripe* stripe, void* data) {
+	LLNode* node = create_llnode(data);
+	if (node == NULL) return 0;
+	pthread_mutex_lock(&stripe->lock);
+	insertNodeTail(stripe->list, node);
+	__atomic_store_n(&stripe->size, getSize(stripe->list), __ATOMIC_RELAXED);
+	pthread_mutex_unlock(&stripe->lock);
+	return 1;
+}
+
+ShardedList* create_shardedlist(unsigned stripes) {
+	// Round the stripe count up to a power of two
+	unsigned count = 1;
+	while (count < stripes) count <<= 1;
+
+	// Create space for the list and its stripes
+	ShardedList* sl = (ShardedList *) malloc(sizeof(ShardedList));
+	if (sl == NULL) return NULL;
+	sl->stripes = (ShardStripe *) aligned_alloc(SHARD_CACHE_LINE, count * sizeof(ShardStripe));
+	if (sl->stripes == NULL) {
+		free(sl);
+		return NULL;
+	}
+	for (unsigned i = 0; i < count; i++) {
+		sl->stripes[i].list = create_dlinkedlist();
+		if (sl->stripes[i].list == NULL) {
+			while (i--) destroyList(sl->stripes[i].list);
+			free(sl->stripes);
+			free(sl);
+			return NULL;
+		}
+		pthread_mutex_init(&sl->stripes[i].lock, NULL);
+		sl->stripes[i].size = 0;
+	}
+	sl->mask = count - 1;
+	return sl;
+}
+
+void destroyShardedList(ShardedList* sl) {
+	for (unsigned i = 0; i <= sl->mask; i++) {
+		destroyList(sl->stripes[i].list);
+		pthread_mutex_destroy(&sl->stripes[i].lock);
+	}
+	free(sl->stripes);
+	free(sl);
+}
+
+int shardedInsertTail(ShardedList* sl, void* data) {
+	if (thread_stripe == 0)
+		thread_stripe = __atomic_fetch_add(&next_stripe, 1, __ATOMIC_RELAXED) + 1;
+	return insert_stripe(&sl->stripes[(thread_stripe - 1) & sl->mask], data);
+}
+
+int shardedInsertKey(ShardedList* sl, uintptr_t key, void* data) {
+	return insert_stripe(&sl->stripes[hashKey(key) & sl->mask], data);
+}
+
+int shardedGetSize(ShardedList* sl) {
+	int size = 0;
+	for (unsigned i = 0; i <= sl->mask; i++)
+		size += __atomic_load_n(&sl->stripes[i].size, __ATOMIC_RELAXED);
+	return size;
+}
+
+int shardedDrain(ShardedList* sl, DLinkedList* dest) {
+	int moved = 0;
+	for (unsigned i = 0; i <= sl->mask; i++) {
+		ShardStripe* stripe = &sl->stripes[i];
+		pthread_mutex_lock(&stripe->lock);
+		int size = getSize(stripe->list);
+		if (appendList(dest, stripe->list)) {
+			moved += size;
+			__atomic_store_n(&stripe->size, 0, __ATOMIC_RELAXED);
+		}
+		pthread_mutex_unlock(&stripe->lock);
+	}
+	return moved;
+}
@@ -0,0 +1,120 @@
+/** @file sharded_list.h */
+#ifndef SHARDEDLIST_H
+#define SHARDEDLIST_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include "doublely_linked_list.h"
+
+/** The cache line size stripes are aligned to */
+#define SHARD_CACHE_LINE 64
+
+
+/********************************************
+ * Sharded list library functions           *
+ * A list split into independently locked   *
+ * DLinkedList stripes. Each thread appends *
+ * to its own stripe, so inserts from       *
+ * different threads do not contend, and    *
+ * draining splices the stripes together.   *
+ ********************************************/
+
+
+/**
+ * This structure represents one stripe: a list, its lock and a size that can
+ * be read without the lock.
+ */
+typedef struct shardstripe_t {
+    /** The stripe's nodes */
+    DLinkedList* list;
+
+    /** Held while the stripe's list is changed */
+    pthread_mutex_t lock;
+
+    /** A copy of the list's size, stored atomically after every change */
+    int size;
+} __attribute__((aligned(SHARD_CACHE_LINE))) ShardStripe;
+
+/**
+ * This structure represents an entire sharded list.
+ */
+typedef struct shardedlist_t {
+    /** The stripes. A power of two of them. */
+    ShardStripe* stripes;
+
+    /** The number of stripes minus one */
+    unsigned mask;
+} ShardedList;
+
+
+/**
+ * create_shardedlist
+ *
+ * Creates an empty sharded list by allocating memory for it on the heap.
+ *
+ * @param stripes The number of stripes, rounded up to a power of two. About
+ *                the number of inserting threads.
+ * @return A pointer to an empty list, or NULL if allocation failed
+ */
+ShardedList* create_shardedlist(unsigned stripes);
+
+/**
+ * destroyShardedList
+ *
+ * Destroy the list. As with destroyList, nodes and data are all freed. No
+ * other thread may be using the list.
+ *
+ * @param sl A pointer to the list
+ */
+void destroyShardedList(ShardedList* sl);
+
+/**
+ * shardedInsertTail
+ *
+ * Append the data to the calling thread's stripe. A thread is given a stripe
+ * the first time it inserts and keeps it, so with at least as many stripes as
+ * threads no two threads share a lock.
+ *
+ * @param sl A pointer to the list
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted, 0 if no node could be allocated
+ */
+int shardedInsertTail(ShardedList* sl, void* data);
+
+/**
+ * shardedInsertKey
+ *
+ * Append the data to the stripe the key hashes to, so that equal keys always
+ * land in the same stripe and stay in insertion order.
+ *
+ * @param sl A pointer to the list
+ * @param key The key choosing the stripe
+ * @param data A void pointer to the data to insert
+ * @return 1 if the data was inserted, 0 if no node could be allocated
+ */
+int shardedInsertKey(ShardedList* sl, uintptr_t key, void* data);
+
+/**
+ * shardedGetSize
+ *
+ * Add up the stripe sizes without locking. Inserts that race with the sum may
+ * or may not be counted.
+ *
+ * @param sl A pointer to the list
+ * @return the approximate size
+ */
+int shardedGetSize(ShardedList* sl);
+
+/**
+ * shardedDrain
+ *
+ * Move every node onto the tail of a list, stripe after stripe, splicing each
+ * stripe on in O(1). Order is kept within a stripe but not across stripes.
+ *
+ * @param sl A pointer to the list
+ * @param dest A pointer to the doublely linked list to append to
+ * @return the number of nodes moved. A stripe that appendList cannot splice
+ *         onto dest, such as onto a list with a key extractor, keeps its nodes.
+ */
+int shardedDrain(ShardedList* sl, DLinkedList* dest);
+#endif
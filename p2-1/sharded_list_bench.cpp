@@ -0,0 +1,73 @@
+// Appends to a sharded list against one mutex around a DLinkedList, from 1
+// to 32 threads, plus the cost of draining the shards back into one list
+//
+// Usage: ./sharded_list_bench [appends per thread] [stripes]
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "sharded_list.h"
+
+struct Workload {
+	ShardedList* sl;
+	DLinkedList* list;
+	pthread_mutex_t mutex;
+	long ops;
+};
+
+static void* sharded_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	for (long i = 0; i < w->ops; i++)
+		shardedInsertTail(w->sl, w);
+	return NULL;
+}
+
+static void* mutex_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	for (long i = 0; i < w->ops; i++) {
+		pthread_mutex_lock(&w->mutex);
+		insertTail(w->list, w);
+		pthread_mutex_unlock(&w->mutex);
+	}
+	return NULL;
+}
+
+int main(int argc, char** argv)
+{
+	Workload w;
+	w.ops = argc > 1 ? atol(argv[1]) : 200000;
+	unsigned stripes = argc > 2 ? atoi(argv[2]) : 16;
+	pthread_mutex_init(&w.mutex, NULL);
+
+	for (int threads = 1; threads <= 32; threads *= 2) {
+		char name[64];
+		double ops = (double) w.ops * threads;
+
+		w.list = create_dlinkedlist();
+		double seconds = benchRunThreads(threads, mutex_body, &w);
+		snprintf(name, sizeof(name), "mutex   threads=%2d", threads);
+		benchReport(name, ops, seconds);
+		benchDrain(w.list);
+		destroyList(w.list);
+
+		w.sl = create_shardedlist(stripes);
+		seconds = benchRunThreads(threads, sharded_body, &w);
+		snprintf(name, sizeof(name), "sharded threads=%2d stripes=%u", threads, w.sl->mask + 1);
+		benchReport(name, ops, seconds);
+
+		// Draining only splices, so its cost does not depend on the size
+		DLinkedList* all = create_dlinkedlist();
+		double begin = benchSeconds();
+		int moved = shardedDrain(w.sl, all);
+		double end = benchSeconds();
+		printf("%-44s %10d nodes %9.2f us\n", "  drain", moved, (end - begin) * 1e6);
+		benchDrain(all);
+		destroyList(all);
+		destroyShardedList(w.sl);
+	}
+
+	pthread_mutex_destroy(&w.mutex);
+	return 0;
+}
@@ -0,0 +1,161 @@
+#include <pthread.h>
+#include <stdint.h>
+#include "sharded_list.h"
+#include "test_util.h"
+#include "gtest/gtest.h"
+
+
+#define WRITERS 4
+#define ITEMS_PER_WRITER 10000
+
+struct WriterArgs {
+	ShardedList* sl;
+	uintptr_t id;
+};
+
+// Appends (id << 24 | sequence) for a run of sequence numbers
+static void* writer_thread(void* arg)
+{
+	WriterArgs* args = (WriterArgs*) arg;
+	for (uintptr_t i = 1; i <= ITEMS_PER_WRITER; i++)
+		shardedInsertTail(args->sl, (void*) (args->id << 24 | i));
+	return NULL;
+}
+
+struct TwoListArgs {
+	ShardedList* first;
+	ShardedList* shared;
+};
+
+// Inserts into its own list first, then into the shared one
+static void* two_list_thread(void* arg)
+{
+	TwoListArgs* args = (TwoListArgs*) arg;
+	shardedInsertTail(args->first, args);
+	shardedInsertTail(args->shared, args);
+	return NULL;
+}
+
+// Key extractor for a destination that refuses the stripes' nodes
+static uint64_t no_key(void* data)
+{
+	(void) data;
+	return 0;
+}
+
+
+TEST(ShardedList, CreateRoundsStripes)
+{
+	ShardedList* sl = create_shardedlist(5);
+	ASSERT_TRUE(sl != NULL);
+	EXPECT_EQ(7u, sl->mask);
+	EXPECT_EQ(0, shardedGetSize(sl));
+	destroyShardedList(sl);
+}
+
+TEST(ShardedList, KeysKeepTheirOrder)
+{
+	ShardedList* sl = create_shardedlist(8);
+	for (uintptr_t i = 1; i <= 100; i++)
+		ASSERT_EQ(1, shardedInsertKey(sl, i % 10, (void*) i));
+	EXPECT_EQ(100, shardedGetSize(sl));
+
+	// Items with the same key come out in the order they went in
+	DLinkedList* all = create_dlinkedlist();
+	EXPECT_EQ(100, shardedDrain(sl, all));
+	EXPECT_EQ(100, getSize(all));
+	EXPECT_EQ(0, shardedGetSize(sl));
+	uintptr_t last[10] = {0};
+	for (void* d = getHead(all); d != NULL; d = getNext(all)) {
+		uintptr_t i = (uintptr_t) d;
+		ASSERT_LT(last[i % 10], i);
+		last[i % 10] = i;
+	}
+
+	testDrain(all);
+	destroyList(all);
+	destroyShardedList(sl);
+}
+
+TEST(ShardedList, ThreadsAppendAndDrain)
+{
+	ShardedList* sl = create_shardedlist(WRITERS);
+	pthread_t threads[WRITERS];
+	WriterArgs args[WRITERS];
+	for (uintptr_t w = 0; w < WRITERS; w++) {
+		args[w].sl = sl;
+		args[w].id = w;
+		pthread_create(&threads[w], NULL, writer_thread, &args[w]);
+	}
+	for (int w = 0; w < WRITERS; w++)
+		pthread_join(threads[w], NULL);
+	EXPECT_EQ(WRITERS * ITEMS_PER_WRITER, shardedGetSize(sl));
+
+	// Every item arrives once, and each writer's items stay in order
+	DLinkedList* all = create_dlinkedlist();
+	EXPECT_EQ(WRITERS * ITEMS_PER_WRITER, shardedDrain(sl, all));
+	uintptr_t last[WRITERS] = {0};
+	for (void* d = getHead(all); d != NULL; d = getNext(all)) {
+		uintptr_t w = (uintptr_t) d >> 24, seq = (uintptr_t) d & 0xffffff;
+		ASSERT_LT(w, (uintptr_t) WRITERS);
+		ASSERT_EQ(last[w] + 1, seq);
+		last[w] = seq;
+	}
+	for (int w = 0; w < WRITERS; w++)
+		EXPECT_EQ((uintptr_t) ITEMS_PER_WRITER, last[w]);
+
+	testDrain(all);
+	destroyList(all);
+	destroyShardedList(sl);
+}
+
+TEST(ShardedList, StripesAreNotPerFirstList)
+{
+	// Each thread meets a different list first. They must still get
+	// different stripes in the list they share.
+	ShardedList* shared = create_shardedlist(2);
+	ShardedList* firsts[2];
+	TwoListArgs args[2];
+	for (int t = 0; t < 2; t++) {
+		firsts[t] = create_shardedlist(2);
+		args[t].first = firsts[t];
+		args[t].shared = shared;
+		pthread_t thread;
+		pthread_create(&thread, NULL, two_list_thread, &args[t]);
+		pthread_join(thread, NULL);
+	}
+	EXPECT_EQ(1, __atomic_load_n(&shared->stripes[0].size, __ATOMIC_RELAXED));
+	EXPECT_EQ(1, __atomic_load_n(&shared->stripes[1].size, __ATOMIC_RELAXED));
+
+	for (int t = 0; t < 2; t++) {
+		testDrain(firsts[t]->stripes[0].list);
+		testDrain(firsts[t]->stripes[1].list);
+		destroyShardedList(firsts[t]);
+	}
+	testDrain(shared->stripes[0].list);
+	testDrain(shared->stripes[1].list);
+	destroyShardedList(shared);
+}
+
+TEST(ShardedList, FailedDrainKeepsNodes)
+{
+	ShardedList* sl = create_shardedlist(4);
+	for (uintptr_t i = 1; i <= 20; i++) shardedInsertKey(sl, i, (void*) i);
+
+	// A keyed list cannot take plain nodes, so nothing moves or is counted
+	DLinkedList* keyed = create_dlinkedlist();
+	enableKeys(keyed, no_key);
+	EXPECT_EQ(0, shardedDrain(sl, keyed));
+	EXPECT_EQ(0, getSize(keyed));
+	EXPECT_EQ(20, shardedGetSize(sl));
+
+	// A plain list still takes them all
+	DLinkedList* all = create_dlinkedlist();
+	EXPECT_EQ(20, shardedDrain(sl, all));
+	EXPECT_EQ(0, shardedGetSize(sl));
+
+	testDrain(all);
+	destroyList(all);
+	destroyList(keyed);
+	destroyShardedList(sl);
+}
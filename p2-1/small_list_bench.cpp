@@ -0,0 +1,101 @@
+// Memory and speed of small lists (0 to 8 nodes) held three ways: a heap
+// list from create_dlinkedlist, a caller-owned DLinkedList set up with
+// init_dlinkedlist, and a caller-owned SmallDLinkedList whose first nodes
+// live inline
+//
+// Usage: ./small_list_bench [lists per size]
+//
+// Memory counts the bytes of caller storage plus every heap chunk a list
+// holds, each chunk as malloc_usable_size plus glibc's 8-byte header. Speed
+// times a list's whole life: set up, fill, walk, empty and tear down.
+
+#include <malloc.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "doublely_linked_list.h"
+
+#define CHUNK_HEADER 8
+
+static uintptr_t sink;
+
+// Bytes of heap a list's nodes hold, leaving out its inline slots
+static size_t node_bytes(DLinkedList* list, SmallDLinkedList* small)
+{
+	size_t bytes = 0;
+	for (LLNode* node = list->head; node != NULL; node = node->next) {
+		if (small != NULL && node >= small->slots && node < small->slots + DLL_INLINE_NODES) continue;
+		bytes += malloc_usable_size(node) + CHUNK_HEADER;
+	}
+	return bytes;
+}
+
+// Fill a list, walk it, then empty it
+static void churn(DLinkedList* list, int size)
+{
+	for (int i = 0; i < size; i++) insertTail(list, list);
+	for (void* d = getHead(list); d != NULL; d = getNext(list)) sink += (uintptr_t) d;
+	benchDrain(list);
+}
+
+int main(int argc, char** argv)
+{
+	long lists = argc > 1 ? atol(argv[1]) : 1000000;
+	int sizes[] = {0, 1, 2, 3, 4, 6, 8};
+	char name[64];
+
+	printf("%-44s %s\n", "bytes per list", "heap  caller-owned  small");
+	for (int s = 0; s < (int) (sizeof(sizes) / sizeof(sizes[0])); s++) {
+		DLinkedList* heap = create_dlinkedlist();
+		DLinkedList owned;
+		SmallDLinkedList small;
+		init_dlinkedlist(&owned);
+		init_smalldlinkedlist(&small);
+		for (int i = 0; i < sizes[s]; i++) {
+			insertTail(heap, heap);
+			insertTail(&owned, heap);
+			insertTail(&small.list, heap);
+		}
+		snprintf(name, sizeof(name), "  size=%d", sizes[s]);
+		printf("%-44s %4zu  %12zu  %5zu\n", name,
+				malloc_usable_size(heap) + CHUNK_HEADER + node_bytes(heap, NULL),
+				sizeof(DLinkedList) + node_bytes(&owned, NULL),
+				sizeof(SmallDLinkedList) + node_bytes(&small.list, &small));
+		benchDrain(heap);
+		destroyList(heap);
+		benchDrain(&owned);
+		benchDrain(&small.list);
+	}
+
+	for (int s = 0; s < (int) (sizeof(sizes) / sizeof(sizes[0])); s++) {
+		int size = sizes[s];
+		double begin = benchSeconds();
+		for (long l = 0; l < lists; l++) {
+			DLinkedList* list = create_dlinkedlist();
+			churn(list, size);
+			destroyList(list);
+		}
+		snprintf(name, sizeof(name), "heap         size=%d", size);
+		benchReport(name, lists, benchSeconds() - begin);
+
+		begin = benchSeconds();
+		for (long l = 0; l < lists; l++) {
+			DLinkedList list;
+			init_dlinkedlist(&list);
+			churn(&list, size);
+			clearList(&list);
+		}
+		snprintf(name, sizeof(name), "caller-owned size=%d", size);
+		benchReport(name, lists, benchSeconds() - begin);
+
+		begin = benchSeconds();
+		for (long l = 0; l < lists; l++) {
+			SmallDLinkedList small;
+			init_smalldlinkedlist(&small);
+			churn(&small.list, size);
+			clearList(&small.list);
+		}
+		snprintf(name, sizeof(name), "small        size=%d", size);
+		benchReport(name, lists, benchSeconds() - begin);
+	}
+	return sink == 0;
+}
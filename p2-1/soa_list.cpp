@@ -0,0 +1,234 @@
+// A doublely-linked list kept as parallel arrays of links and data
+
+#include <stdlib.h>
+#include "soa_list.h"
+
+// The number of slots allocated by the first insert
+#define SOA_MIN_CAPACITY 16
+
+// Grow one array to the new capacity. On failure the old array is kept.
+static int grow(void** array, size_t capacity, size_t size) {
+	void* grown = realloc(*array, capacity * size);
+	if (grown == NULL) return 0;
+	*array = grown;
+	return 1;
+}
+
+// Take a free slot for data, doubling the arrays if none is left
+static uint32_t take_slot(SoAList* list, void* data) {
+	if (list->spare == SOA_NIL) {
+		uint32_t capacity = list->capacity != 0 ? list->capacity * 2 : SOA_MIN_CAPACITY;
+		if (capacity <= list->capacity || !soaReserve(list, capacity)) return SOA_NIL;
+	}
+	uint32_t slot = list->spare;
+	list->spare = list->next[slot];
+	list->data[slot] = data;
+	list->size++;
+	return slot;
+}
+
+// Unlink a slot and chain it onto the free slots
+static void give_slot(SoAList* list, uint32_t slot) {
+	uint32_t next = list->next[slot], previous = list->previous[slot];
+	if (previous != SOA_NIL) list->next[previous] = next;
+	else list->head = next;
+	if (next != SOA_NIL) list->previous[next] = previous;
+	else list->tail = previous;
+
+	list->next[slot] = list->spare;
+	list->spare = slot;
+	list->size--;
+}
+
+// Link a slot in between two neighbors, either of which may be SOA_NIL
+static void link_slot(SoAList* list, uint32_t slot, uint32_t previous, uint32_t next) {
+	list->previous[slot] = previous;
+	list->next[slot] = next;
+	if (previous != SOA_NIL) list->next[previous] = slot;
+	else list->head = slot;
+	if (next != SOA_NIL) list->previous[next] = slot;
+	else list->tail = slot;
+}
+
+// Return the current slot's data, or NULL
+static void* current_data(SoAList* list) {
+	return list->current != SOA_NIL ? list->data[list->current] : NULL;
+}
+
+SoAList* create_soalist(void) {
+	// Create space for the list; the arrays come with the first insert
+	SoAList* list = (SoAList *) malloc(sizeof(SoAList));
+	if (list == NULL) return NULL;
+	list->next = NULL;
+	list->previous = NULL;
+	list->data = NULL;
+	list->head = SOA_NIL;
+	list->tail = SOA_NIL;
+	list->current = SOA_NIL;
+	list->spare = SOA_NIL;
+	list->capacity = 0;
+	list->size = 0;
+	return list;
+}
+
+void destroySoAList(SoAList* list) {
+	// Free the data in the list, then the arrays and the list itself
+	for (uint32_t slot = list->head; slot != SOA_NIL; slot = list->next[slot]) free(list->data[slot]);
+	free(list->next);
+	free(list->previous);
+	free(list->data);
+	free(list);
+}
+
+int soaReserve(SoAList* list, uint32_t capacity) {
+	// Slot numbers must stay below SOA_NIL
+	if (capacity <= list->capacity) return 1;
+	if (capacity == SOA_NIL) return 0;
+
+	// Grow each array. One that grew before a later failure is only roomier.
+	if (!grow((void**) &list->next, capacity, sizeof(uint32_t))) return 0;
+	if (!grow((void**) &list->previous, capacity, sizeof(uint32_t))) return 0;
+	if (!grow((void**) &list->data, capacity, sizeof(void*))) return 0;
+
+	// Chain the new slots onto the free slots, lowest first
+	for (uint32_t slot = capacity; slot-- > list->capacity;) {
+		list->next[slot] = list->spare;
+		list->spare = slot;
+	}
+	list->capacity = capacity;
+	return 1;
+}
+
+int soaInsertHead(SoAList* list, void* data) {
+	uint32_t slot = take_slot(list, data);
+	if (slot == SOA_NIL) return 0;
+	link_slot(list, slot, SOA_NIL, list->head);
+	return 1;
+}
+
+int soaInsertTail(SoAList* list, void* data) {
+	uint32_t slot = take_slot(list, data);
+	if (slot == SOA_NIL) return 0;
+	link_slot(list, slot, list->tail, SOA_NIL);
+	return 1;
+}
+
+int soaInsertAfter(SoAList* list, void* data) {
+	// Only insert if the current slot is in the list
+	if (list->current == SOA_NIL) return 0;
+	uint32_t slot = take_slot(list, data);
+	if (slot == SOA_NIL) return 0;
+	link_slot(list, slot, list->current, list->next[list->current]);
+	return 1;
+}
+
+int soaInsertBefore(SoAList* list, void* data) {
+	// Only insert if the current slot is in the list
+	if (list->current == SOA_NIL) return 0;
+	uint32_t slot = take_slot(list, data);
+	if (slot == SOA_NIL) return 0;
+	link_slot(list, slot, list->previous[list->current], list->current);
+	return 1;
+}
+
+void* soaRemoveForward(SoAList* list) {
+	// Only remove the current slot if it is in the list
+	uint32_t slot = list->current;
+	if (slot == SOA_NIL) return NULL;
+	void* data = list->data[slot];
+	list->current = list->next[slot];
+	give_slot(list, slot);
+	return data;
+}
+
+void* soaRemoveBackward(SoAList* list) {
+	// Only remove the current slot if it is in the list
+	uint32_t slot = list->current;
+	if (slot == SOA_NIL) return NULL;
+	void* data = list->data[slot];
+	list->current = list->previous[slot];
+	give_slot(list, slot);
+	return data;
+}
+
+void* soaDeleteForward(SoAList* list) {
+	free(soaRemoveForward(list));
+	return current_data(list);
+}
+
+void* soaDeleteBackward(SoAList* list) {
+	free(soaRemoveBackward(list));
+	return current_data(list);
+}
+
+void* soaGetHead(SoAList* list) {
+	list->current = list->head;
+	return current_data(list);
+}
+
+void* soaGetTail(SoAList* list) {
+	list->current = list->tail;
+	return current_data(list);
+}
+
+void* soaGetCurrent(SoAList* list) {
+	return current_data(list);
+}
+
+void* soaGetNext(SoAList* list) {
+	// Only move if the current slot is in the list
+	if (list->current == SOA_NIL) return NULL;
+	list->current = list->next[list->current];
+	return current_data(list);
+}
+
+void* soaGetPrevious(SoAList* list) {
+	// Only move if the current slot is in the list
+	if (list->current == SOA_NIL) return NULL;
+	list->current = list->previous[list->current];
+	return current_data(list);
+}
+
+int soaGetSize(SoAList* list) {
+	return list->size;
+}
+
+int soaCompact(SoAList* list) {
+	// Nothing to renumber in a list that never allocated
+	if (list->capacity == 0) return 1;
+
+	// Build the new arrays in list order, so slot i is the i-th element
+	uint32_t* next = (uint32_t *) malloc(list->capacity * sizeof(uint32_t));
+	uint32_t* previous = (uint32_t *) malloc(list->capacity * sizeof(uint32_t));
+	void** data = (void **) malloc(list->capacity * sizeof(void*));
+	if (next == NULL || previous == NULL || data == NULL) {
+		free(next);
+		free(previous);
+		free(data);
+		return 0;
+	}
+	uint32_t count = 0, current = SOA_NIL;
+	for (uint32_t slot = list->head; slot != SOA_NIL; slot = list->next[slot], count++) {
+		if (slot == list->current) current = count;
+		data[count] = list->data[slot];
+		previous[count] = count != 0 ? count - 1 : SOA_NIL;
+		next[count] = count + 1;
+	}
+	if (count != 0) next[count - 1] = SOA_NIL;
+
+	// The free slots follow the list's, in order
+	for (uint32_t slot = count; slot < list->capacity; slot++) next[slot] = slot + 1 < list->capacity ? slot + 1 : SOA_NIL;
+
+	// Swap the new arrays in
+	free(list->next);
+	free(list->previous);
+	free(list->data);
+	list->next = next;
+	list->previous = previous;
+	list->data = data;
+	list->head = count != 0 ? 0 : SOA_NIL;
+	list->tail = count != 0 ? count - 1 : SOA_NIL;
+	list->current = current;
+	list->spare = count < list->capacity ? count : SOA_NIL;
+	return 1;
+}
@@ -0,0 +1,105 @@
+// The struct-of-arrays list against DLinkedList's node-per-element layout:
+// forward and backward walks, mixed insert/remove churn at a moving cursor,
+// and a forward walk after the churn has scattered the list. The data
+// pointers are never dereferenced, so the walks measure only the links.
+//
+// Usage: ./soa_list_bench [elements]
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "doublely_linked_list.h"
+#include "soa_list.h"
+
+#define PASSES 4
+
+static uintptr_t sums[2];
+
+static void walk_dll(DLinkedList* list, const char* name, int forward)
+{
+	double begin = benchSeconds();
+	for (int pass = 0; pass < PASSES; pass++) {
+		if (forward) for (void* d = getHead(list); d != NULL; d = getNext(list)) sums[0] += (uintptr_t) d;
+		else for (void* d = getTail(list); d != NULL; d = getPrevious(list)) sums[0] += (uintptr_t) d;
+	}
+	benchReport(name, (double) PASSES * getSize(list), benchSeconds() - begin);
+}
+
+static void walk_soa(SoAList* list, const char* name, int forward)
+{
+	double begin = benchSeconds();
+	for (int pass = 0; pass < PASSES; pass++) {
+		if (forward) for (void* d = soaGetHead(list); d != NULL; d = soaGetNext(list)) sums[1] += (uintptr_t) d;
+		else for (void* d = soaGetTail(list); d != NULL; d = soaGetPrevious(list)) sums[1] += (uintptr_t) d;
+	}
+	benchReport(name, (double) PASSES * soaGetSize(list), benchSeconds() - begin);
+}
+
+int main(int argc, char** argv)
+{
+	long n = argc > 1 ? atol(argv[1]) : 1000000;
+
+	// Build both lists in order
+	double begin = benchSeconds();
+	DLinkedList* dll = create_dlinkedlist();
+	for (long i = 0; i < n; i++) insertTail(dll, (void*) (uintptr_t) (i + 1));
+	benchReport("nodes  build", n, benchSeconds() - begin);
+
+	begin = benchSeconds();
+	SoAList* soa = create_soalist();
+	for (long i = 0; i < n; i++) soaInsertTail(soa, (void*) (uintptr_t) (i + 1));
+	benchReport("arrays build", n, benchSeconds() - begin);
+
+	walk_dll(dll, "nodes  forward walk", 1);
+	walk_soa(soa, "arrays forward walk", 1);
+	walk_dll(dll, "nodes  backward walk", 0);
+	walk_soa(soa, "arrays backward walk", 0);
+
+	// Churn: at each step, insert after the cursor or remove at it, then
+	// move on, with the same choices for both lists
+	uint64_t seed = 1;
+	begin = benchSeconds();
+	getHead(dll);
+	for (long i = 0; i < n; i++) {
+		if (getCurrent(dll) == NULL) getHead(dll);
+		if (benchRandom(&seed) & 1) removeForward(dll);
+		else {
+			insertAfter(dll, (void*) (uintptr_t) (n + i + 1));
+			getNext(dll);
+			getNext(dll);
+		}
+	}
+	benchReport("nodes  churn", n, benchSeconds() - begin);
+
+	seed = 1;
+	begin = benchSeconds();
+	soaGetHead(soa);
+	for (long i = 0; i < n; i++) {
+		if (soaGetCurrent(soa) == NULL) soaGetHead(soa);
+		if (benchRandom(&seed) & 1) soaRemoveForward(soa);
+		else {
+			soaInsertAfter(soa, (void*) (uintptr_t) (n + i + 1));
+			soaGetNext(soa);
+			soaGetNext(soa);
+		}
+	}
+	benchReport("arrays churn", n, benchSeconds() - begin);
+
+	// Walk what the churn left, which both lists must agree on, then again
+	// with the arrays in list order
+	walk_dll(dll, "nodes  forward walk after churn", 1);
+	walk_soa(soa, "arrays forward walk after churn", 1);
+	int same = sums[0] == sums[1] && getSize(dll) == soaGetSize(soa);
+	begin = benchSeconds();
+	soaCompact(soa);
+	benchReport("arrays compact", soaGetSize(soa), benchSeconds() - begin);
+	walk_soa(soa, "arrays forward walk after compact", 1);
+
+	// The data pointers are fake, so empty the lists before destroying them
+	benchDrain(dll);
+	destroyList(dll);
+	soaGetHead(soa);
+	while (soaGetCurrent(soa) != NULL) soaRemoveForward(soa);
+	destroySoAList(soa);
+	return !same;
+}
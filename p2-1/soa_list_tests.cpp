@@ -0,0 +1,105 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include "soa_list.h"
+#include "gtest/gtest.h"
+
+
+// Check that a walk both ways sees the expected data, in order
+static void expect_order(SoAList* list, const uintptr_t* expected, int n)
+{
+	int i = 0;
+	for (void* d = soaGetHead(list); d != NULL; d = soaGetNext(list)) EXPECT_EQ(expected[i++], (uintptr_t) d);
+	EXPECT_EQ(n, i);
+	for (void* d = soaGetTail(list); d != NULL; d = soaGetPrevious(list)) EXPECT_EQ(expected[--i], (uintptr_t) d);
+	EXPECT_EQ(0, i);
+	EXPECT_EQ(n, soaGetSize(list));
+}
+
+
+TEST(SoAList, CreateDestroy)
+{
+	SoAList* list = create_soalist();
+	ASSERT_TRUE(list != NULL);
+	EXPECT_EQ(0, soaGetSize(list));
+	EXPECT_EQ(NULL, soaGetHead(list));
+	EXPECT_EQ(NULL, soaGetNext(list));
+	EXPECT_EQ(NULL, soaRemoveForward(list));
+	EXPECT_EQ(0, soaInsertAfter(list, (void*) 1));
+	EXPECT_EQ(1, soaCompact(list));
+	destroySoAList(list);
+}
+
+TEST(SoAList, CursorMatchesDLinkedList)
+{
+	SoAList* list = create_soalist();
+	soaInsertTail(list, (void*) 2);
+	soaInsertHead(list, (void*) 1);
+	soaGetTail(list);
+	EXPECT_EQ(1, soaInsertAfter(list, (void*) 4));
+	EXPECT_EQ(1, soaInsertBefore(list, (void*) 3));
+	EXPECT_EQ((void*) 2, soaGetCurrent(list));
+	uintptr_t expected[] = {1, 3, 2, 4};
+	expect_order(list, expected, 4);
+
+	// Removing moves the current slot the way DLinkedList's does
+	soaGetHead(list);
+	soaGetNext(list);
+	EXPECT_EQ((void*) 3, soaRemoveForward(list));
+	EXPECT_EQ((void*) 2, soaGetCurrent(list));
+	EXPECT_EQ((void*) 2, soaRemoveBackward(list));
+	EXPECT_EQ((void*) 1, soaGetCurrent(list));
+	EXPECT_EQ((void*) 1, soaRemoveBackward(list));
+	EXPECT_EQ(NULL, soaGetCurrent(list));
+	uintptr_t rest[] = {4};
+	expect_order(list, rest, 1);
+
+	// Delete frees the data, and destroy frees what is left
+	soaInsertHead(list, malloc(16));
+	soaGetHead(list);
+	EXPECT_EQ((void*) 4, soaDeleteForward(list));
+	soaRemoveForward(list);
+	soaInsertTail(list, malloc(16));
+	destroySoAList(list);
+}
+
+TEST(SoAList, ChurnReusesSlotsAndCompacts)
+{
+	SoAList* list = create_soalist();
+	ASSERT_EQ(1, soaReserve(list, 64));
+	for (uintptr_t i = 1; i <= 64; i++) ASSERT_EQ(1, soaInsertTail(list, (void*) i));
+	EXPECT_EQ(64u, list->capacity);
+
+	// Remove every other element, then put them back at the head
+	soaGetHead(list);
+	while (soaGetCurrent(list) != NULL) {
+		soaRemoveForward(list);
+		soaGetNext(list);
+	}
+	EXPECT_EQ(32, soaGetSize(list));
+	for (uintptr_t i = 63; i >= 1 && i <= 63; i -= 2) soaInsertHead(list, (void*) i);
+	EXPECT_EQ(64u, list->capacity);
+
+	// Compacting keeps the order and the current data, and numbers slots in order
+	uintptr_t expected[64];
+	for (int i = 0; i < 32; i++) {
+		expected[i] = 1 + 2 * i;
+		expected[32 + i] = 2 + 2 * i;
+	}
+	soaGetHead(list);
+	for (int i = 0; i < 40; i++) soaGetNext(list);
+	EXPECT_EQ(1, soaCompact(list));
+	EXPECT_EQ((void*) expected[40], soaGetCurrent(list));
+	EXPECT_EQ(40u, list->current);
+	for (uint32_t slot = 0; slot < 64; slot++) EXPECT_EQ(expected[slot], (uintptr_t) list->data[slot]);
+	expect_order(list, expected, 64);
+
+	// The arrays grow once the slots run out
+	EXPECT_EQ(1, soaInsertTail(list, (void*) 65));
+	EXPECT_EQ(128u, list->capacity);
+	EXPECT_EQ(65, soaGetSize(list));
+
+	// Empty the list without freeing the fake data
+	soaGetHead(list);
+	while (soaGetCurrent(list) != NULL) soaRemoveForward(list);
+	destroySoAList(list);
+}
@@ -0,0 +1,122 @@
+// A uniform spatial grid of doublely-linked list cells
+
+#include <stdlib.h>
+#include "spatial_grid.h"
+
+// Divide, rounding toward negative infinity so cells tile negative coordinates too
+static int floor_div(int a, int b) {
+	int q = a / b;
+	if ((a % b != 0) && ((a < 0) != (b < 0))) q--;
+	return q;
+}
+
+// Wrap a cell coordinate onto the grid
+static int wrap(int c, int n) {
+	int r = c % n;
+	return r < 0 ? r + n : r;
+}
+
+// Find the index of the cell holding a position
+static int cell_of(SpatialGrid* grid, int x, int y) {
+	int column = wrap(floor_div(x, grid->cellSize), grid->columns);
+	int row = wrap(floor_div(y, grid->cellSize), grid->rows);
+	return row * grid->columns + column;
+}
+
+SpatialGrid* create_spatialgrid(int cellSize, int columns, int rows) {
+	// Create space for the grid and its cells. An all-zero DLinkedList is an
+	// empty list, so calloc gives empty cells.
+	SpatialGrid* grid = (SpatialGrid *) malloc(sizeof(SpatialGrid));
+	if (grid == NULL) return NULL;
+	grid->cells = (DLinkedList *) calloc((size_t) columns * rows, sizeof(DLinkedList));
+	if (grid->cells == NULL) {
+		free(grid);
+		return NULL;
+	}
+
+	// Initialize the dimensions
+	grid->cellSize = cellSize;
+	grid->columns = columns;
+	grid->rows = rows;
+	grid->size = 0;
+	return grid;
+}
+
+void destroySpatialGrid(SpatialGrid* grid) {
+	// Free every object handle in every cell
+	for (int i = 0; i < grid->columns * grid->rows; i++) {
+		LLNode* node = grid->cells[i].head;
+		while (node != NULL) {
+			LLNode* next = node->next;
+			free(node);
+			node = next;
+		}
+	}
+
+	// Free up the grid's memory
+	free(grid->cells);
+	free(grid);
+}
+
+GridObject* gridInsert(SpatialGrid* grid, void* data, int x, int y) {
+	// Create the handle
+	GridObject* object = (GridObject *) malloc(sizeof(GridObject));
+	if (object == NULL) return NULL;
+	object->node.data = data;
+	object->x = x;
+	object->y = y;
+	object->cell = cell_of(grid, x, y);
+
+	// Link it into its cell
+	insertNodeTail(&grid->cells[object->cell], &object->node);
+	grid->size++;
+	return object;
+}
+
+void gridMove(SpatialGrid* grid, GridObject* object, int x, int y) {
+	object->x = x;
+	object->y = y;
+
+	// Only relink the node if the object changed cells
+	int cell = cell_of(grid, x, y);
+	if (cell == object->cell) return;
+	detachNode(&grid->cells[object->cell], &object->node);
+	insertNodeTail(&grid->cells[cell], &object->node);
+	object->cell = cell;
+}
+
+void* gridRemove(SpatialGrid* grid, GridObject* object) {
+	// Unlink and free the handle
+	void* data = object->node.data;
+	detachNode(&grid->cells[object->cell], &object->node);
+	free(object);
+	grid->size--;
+	return data;
+}
+
+int gridQuery(SpatialGrid* grid, int x0, int y0, int x1, int y1, GridVisitFn visit, void* context) {
+	// Find the span of cells the rectangle overlaps, never visiting a cell twice
+	int cx0 = floor_div(x0, grid->cellSize), cx1 = floor_div(x1, grid->cellSize);
+	int cy0 = floor_div(y0, grid->cellSize), cy1 = floor_div(y1, grid->cellSize);
+	if (cx1 - cx0 >= grid->columns) cx1 = cx0 + grid->columns - 1;
+	if (cy1 - cy0 >= grid->rows) cy1 = cy0 + grid->rows - 1;
+
+	// Walk the overlapping cells, checking each object's exact position
+	int visited = 0;
+	for (int cy = cy0; cy <= cy1; cy++) {
+		DLinkedList* row = &grid->cells[wrap(cy, grid->rows) * grid->columns];
+		for (int cx = cx0; cx <= cx1; cx++) {
+			for (LLNode* node = row[wrap(cx, grid->columns)].head; node != NULL; node = node->next) {
+				GridObject* object = (GridObject *) node;
+				if (object->x < x0 || object->x > x1 || object->y < y0 || object->y > y1) continue;
+				visited++;
+				if (visit != NULL && visit(node->data, object->x, object->y, context)) return visited;
+			}
+		}
+	}
+	return visited;
+}
+
+int gridCount(SpatialGrid* grid) {
+	return grid->size;
+}
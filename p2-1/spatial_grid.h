@@ -0,0 +1,153 @@
+/** @file spatial_grid.h */
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "doublely_linked_list.h"
+
+
+/********************************************
+ * Spatial grid library functions           *
+ * A uniform grid of doublely linked list   *
+ * cells for finding the objects near a     *
+ * point without walking every object.      *
+ ********************************************/
+
+
+/**
+ * This structure represents an object placed in the grid. It is the handle
+ * returned by gridInsert. The node's data pointer is the caller's data.
+ */
+typedef struct gridobject_t {
+    /** The node linking this object into its cell. Must be first. */
+    LLNode node;
+
+    /** The object's x coordinate */
+    int x;
+
+    /** The object's y coordinate */
+    int y;
+
+    /** The index of the cell the object is linked into */
+    int cell;
+} GridObject;
+
+/**
+ * This structure represents an entire spatial grid. The world is unbounded:
+ * cell coordinates wrap around the grid, so far-apart objects may share a
+ * cell, and queries check each object's exact position.
+ */
+typedef struct spatialgrid_t {
+    /** The cells, row by row */
+    DLinkedList* cells;
+
+    /** The width and height of a cell in world units */
+    int cellSize;
+
+    /** The number of cells across */
+    int columns;
+
+    /** The number of cells down */
+    int rows;
+
+    /** The number of objects in the grid */
+    int size;
+} SpatialGrid;
+
+/**
+ * Callback invoked for each object a query finds.
+ *
+ * @param data The object's data pointer
+ * @param x The object's x coordinate
+ * @param y The object's y coordinate
+ * @param context The context pointer given to gridQuery
+ * @return 0 to continue the query, anything else to stop it
+ */
+typedef int (*GridVisitFn)(void* data, int x, int y, void* context);
+
+
+/**
+ * create_spatialgrid
+ *
+ * Creates an empty spatial grid by allocating memory for it on the heap.
+ * Choose the cell size near the typical query size.
+ *
+ * @param cellSize The width and height of a cell in world units. Must be positive.
+ * @param columns The number of cells across. Must be positive.
+ * @param rows The number of cells down. Must be positive.
+ * @return A pointer to an empty spatial grid, or NULL if allocation failed
+ */
+SpatialGrid* create_spatialgrid(int cellSize, int columns, int rows);
+
+/**
+ * destroySpatialGrid
+ *
+ * Destroy the spatial grid and every object handle in it. The data is not freed.
+ *
+ * @param grid A pointer to the spatial grid
+ */
+void destroySpatialGrid(SpatialGrid* grid);
+
+/**
+ * gridInsert
+ *
+ * Place data in the grid at a position.
+ *
+ * @param grid A pointer to the spatial grid
+ * @param data A void pointer to the data to place
+ * @param x The x coordinate
+ * @param y The y coordinate
+ * @return the object's handle, or NULL if allocation failed
+ */
+GridObject* gridInsert(SpatialGrid* grid, void* data, int x, int y);
+
+/**
+ * gridMove
+ *
+ * Move an object to a new position. When it changes cells, its node is
+ * relinked into the new cell; nothing is allocated or freed.
+ *
+ * @param grid A pointer to the spatial grid
+ * @param object The handle returned by gridInsert
+ * @param x The new x coordinate
+ * @param y The new y coordinate
+ */
+void gridMove(SpatialGrid* grid, GridObject* object, int x, int y);
+
+/**
+ * gridRemove
+ *
+ * Remove an object from the grid and free its handle.
+ *
+ * @param grid A pointer to the spatial grid
+ * @param object The handle returned by gridInsert
+ * @return the object's data
+ */
+void* gridRemove(SpatialGrid* grid, GridObject* object);
+
+/**
+ * gridQuery
+ *
+ * Visit every object inside a rectangle, edges included. Only the cells the
+ * rectangle overlaps are walked.
+ *
+ * @param grid A pointer to the spatial grid
+ * @param x0 The smallest x coordinate of the rectangle
+ * @param y0 The smallest y coordinate of the rectangle
+ * @param x1 The largest x coordinate of the rectangle
+ * @param y1 The largest y coordinate of the rectangle
+ * @param visit Called for each object found
+ * @param context Passed through to visit
+ * @return the number of objects visited
+ */
+int gridQuery(SpatialGrid* grid, int x0, int y0, int x1, int y1, GridVisitFn visit, void* context);
+
+/**
+ * gridCount
+ *
+ * Return the number of objects in the spatial grid
+ *
+ * @param grid A pointer to the spatial grid
+ * @return the number of objects
+ */
+int gridCount(SpatialGrid* grid);
+#endif
@@ -0,0 +1,99 @@
+// Moving objects and neighborhood queries on the spatial grid, compared with
+// scanning a single DLinkedList of every object
+//
+// Usage: ./spatial_grid_bench [largest object count]
+
+#include <stdlib.h>
+#include "bench_util.h"
+#include "doublely_linked_list.h"
+#include "spatial_grid.h"
+
+#define WORLD 4096
+#define CELL 32
+#define RADIUS 32
+#define FRAMES 4
+#define GRID_QUERIES 1000
+#define LIST_QUERIES 10
+
+// A game object as the flat list stores it
+struct Thing {
+	int x, y, dx, dy;
+	GridObject* handle;
+};
+
+static int step(int v, int d)
+{
+	return (v + d + WORLD) % WORLD;
+}
+
+// Query the list the way the game does today: walk every object
+static int list_query(DLinkedList* list, int x0, int y0, int x1, int y1)
+{
+	int found = 0;
+	for (Thing* t = (Thing*) getHead(list); t != NULL; t = (Thing*) getNext(list)) {
+		if (t->x >= x0 && t->x <= x1 && t->y >= y0 && t->y <= y1) found++;
+	}
+	return found;
+}
+
+static void run(size_t n)
+{
+	char name[64];
+	uint64_t rng = 88172645463325252ULL;
+	Thing* things = (Thing*) malloc(n * sizeof(Thing));
+	SpatialGrid* grid = create_spatialgrid(CELL, WORLD / CELL, WORLD / CELL);
+	DLinkedList* list = create_dlinkedlist();
+	for (size_t i = 0; i < n; i++) {
+		things[i].x = benchRandom(&rng) % WORLD;
+		things[i].y = benchRandom(&rng) % WORLD;
+		things[i].dx = (int) (benchRandom(&rng) % 9) - 4;
+		things[i].dy = (int) (benchRandom(&rng) % 9) - 4;
+		things[i].handle = gridInsert(grid, &things[i], things[i].x, things[i].y);
+		insertTail(list, &things[i]);
+	}
+
+	// Move every object each frame
+	double start = benchSeconds();
+	for (int f = 0; f < FRAMES; f++) {
+		for (size_t i = 0; i < n; i++) {
+			things[i].x = step(things[i].x, things[i].dx);
+			things[i].y = step(things[i].y, things[i].dy);
+			gridMove(grid, things[i].handle, things[i].x, things[i].y);
+		}
+	}
+	snprintf(name, sizeof(name), "grid move   n=%zu", n);
+	benchReport(name, (double) n * FRAMES, benchSeconds() - start);
+
+	// Query neighborhoods around random points
+	long found = 0;
+	start = benchSeconds();
+	for (int q = 0; q < GRID_QUERIES; q++) {
+		int x = benchRandom(&rng) % WORLD, y = benchRandom(&rng) % WORLD;
+		found += gridQuery(grid, x - RADIUS, y - RADIUS, x + RADIUS, y + RADIUS, NULL, NULL);
+	}
+	snprintf(name, sizeof(name), "grid query  n=%zu (%ld hits/q)", n, found / GRID_QUERIES);
+	benchReport(name, GRID_QUERIES, benchSeconds() - start);
+
+	found = 0;
+	start = benchSeconds();
+	for (int q = 0; q < LIST_QUERIES; q++) {
+		int x = benchRandom(&rng) % WORLD, y = benchRandom(&rng) % WORLD;
+		found += list_query(list, x - RADIUS, y - RADIUS, x + RADIUS, y + RADIUS);
+	}
+	snprintf(name, sizeof(name), "list query  n=%zu (%ld hits/q)", n, found / LIST_QUERIES);
+	benchReport(name, LIST_QUERIES, benchSeconds() - start);
+
+	// The list only holds borrowed pointers, so empty it before destroying it
+	benchDrain(list);
+	destroyList(list);
+	destroySpatialGrid(grid);
+	free(things);
+}
+
+int main(int argc, char** argv)
+{
+	size_t largest = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+	for (size_t n = 10000; n <= largest; n *= 10)
+		run(n);
+	return 0;
+}
@@ -0,0 +1,82 @@
+#include "spatial_grid.h"
+#include "gtest/gtest.h"
+
+
+// Counts the objects a query hands over
+static int count_visit(void* data, int x, int y, void* context)
+{
+	(void) data; (void) x; (void) y;
+	(*(int*) context)++;
+	return 0;
+}
+
+// Stops a query at the first object
+static int stop_visit(void* data, int x, int y, void* context)
+{
+	(void) x; (void) y;
+	*(void**) context = data;
+	return 1;
+}
+
+
+TEST(SpatialGrid, CreateDestroy)
+{
+	SpatialGrid* grid = create_spatialgrid(16, 8, 8);
+	ASSERT_TRUE(grid != NULL);
+	EXPECT_EQ(0, gridCount(grid));
+	EXPECT_EQ(0, gridQuery(grid, -1000, -1000, 1000, 1000, NULL, NULL));
+	destroySpatialGrid(grid);
+}
+
+TEST(SpatialGrid, Query)
+{
+	int items[4];
+	SpatialGrid* grid = create_spatialgrid(16, 8, 8);
+	gridInsert(grid, &items[0], 5, 5);
+	gridInsert(grid, &items[1], 20, 5);
+	gridInsert(grid, &items[2], -3, -40);
+	gridInsert(grid, &items[3], 5 + 16 * 8, 5);
+	EXPECT_EQ(4, gridCount(grid));
+
+	// Only objects inside the rectangle count, even when they share a cell
+	int count = 0;
+	EXPECT_EQ(2, gridQuery(grid, 0, 0, 31, 31, count_visit, &count));
+	EXPECT_EQ(2, count);
+	EXPECT_EQ(1, gridQuery(grid, -10, -50, 0, -30, NULL, NULL));
+	EXPECT_EQ(4, gridQuery(grid, -1000, -1000, 1000, 1000, NULL, NULL));
+
+	// The visitor can stop the query early
+	void* first = NULL;
+	EXPECT_EQ(1, gridQuery(grid, 0, 0, 31, 31, stop_visit, &first));
+	EXPECT_TRUE(first == &items[0] || first == &items[1]);
+
+	destroySpatialGrid(grid);
+}
+
+TEST(SpatialGrid, MoveRelinks)
+{
+	int item;
+	SpatialGrid* grid = create_spatialgrid(16, 8, 8);
+	GridObject* object = gridInsert(grid, &item, 1, 1);
+	ASSERT_TRUE(object != NULL);
+
+	// Moving within a cell keeps the node where it is
+	int cell = object->cell;
+	gridMove(grid, object, 10, 10);
+	EXPECT_EQ(cell, object->cell);
+	EXPECT_EQ(1, gridQuery(grid, 10, 10, 10, 10, NULL, NULL));
+
+	// Moving across cells relinks the same node
+	LLNode* node = &object->node;
+	gridMove(grid, object, 40, 70);
+	EXPECT_NE(cell, object->cell);
+	EXPECT_EQ(0, getSize(&grid->cells[cell]));
+	EXPECT_EQ(node, grid->cells[object->cell].head);
+	EXPECT_EQ(0, gridQuery(grid, 0, 0, 16, 16, NULL, NULL));
+	EXPECT_EQ(1, gridQuery(grid, 32, 64, 47, 79, NULL, NULL));
+
+	// Removing hands back the data
+	EXPECT_EQ(&item, gridRemove(grid, object));
+	EXPECT_EQ(0, gridCount(grid));
+	destroySpatialGrid(grid);
+}
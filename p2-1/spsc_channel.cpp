@@ -0,0 +1,147 @@
+// A bounded single-producer, single-consumer channel of pointers
+
+#include <sched.h>
+#include <stdlib.h>
+#include "spsc_channel.h"
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Called by spscReceive between its look at closed and its look at tail.
+// Tests set it to act inside that window; it is NULL otherwise.
+void (*spscReceiveWindowHook)(SPSCChannel* channel) = NULL;
+
+// Sleep while this end's waiting flag is still set
+static void wait_on(uint32_t* waiting) {
+#ifdef __linux__
+	syscall(SYS_futex, waiting, FUTEX_WAIT_PRIVATE, 1, NULL, NULL, 0);
+#else
+	if (__atomic_load_n(waiting, __ATOMIC_ACQUIRE)) sched_yield();
+#endif
+}
+
+// Wake the other end if its waiting flag is set. Clearing the flag first
+// means a wake that arrives before the other end sleeps is not lost. The
+// fence orders the caller's last store before the check, pairing with the
+// one after the flag is set. It is a full fence on every send and receive,
+// but without it a store-load reordering could leave the other end asleep
+// on a message or a free slot.
+static void wake_on(uint32_t* waiting) {
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (!__atomic_load_n(waiting, __ATOMIC_RELAXED)) return;
+	__atomic_store_n(waiting, 0, __ATOMIC_RELEASE);
+#ifdef __linux__
+	syscall(SYS_futex, waiting, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#endif
+}
+
+SPSCChannel* create_spscchannel(uint32_t capacity) {
+	// Round the capacity up to a power of two, which must fit in 32 bits
+	if (capacity > UINT32_C(1) << 31) return NULL;
+	uint32_t count = 1;
+	while (count < capacity) count <<= 1;
+
+	// Create space for the channel and its slots
+	SPSCChannel* channel = (SPSCChannel *) aligned_alloc(SPSC_CACHE_LINE,
+			(sizeof(SPSCChannel) + SPSC_CACHE_LINE - 1) / SPSC_CACHE_LINE * SPSC_CACHE_LINE);
+	if (channel == NULL) return NULL;
+	channel->ring = (void**) malloc(count * sizeof(void*));
+	if (channel->ring == NULL) {
+		free(channel);
+		return NULL;
+	}
+	channel->tail = channel->headCache = 0;
+	channel->head = channel->tailCache = 0;
+	channel->producerWaiting = channel->consumerWaiting = 0;
+	channel->mask = count - 1;
+	channel->closed = 0;
+	return channel;
+}
+
+void destroySPSCChannel(SPSCChannel* channel) {
+	free(channel->ring);
+	free(channel);
+}
+
+int spscTrySend(SPSCChannel* channel, void* data) {
+	// Only reread head when the cached copy says the ring is full
+	uint32_t tail = channel->tail;
+	if (tail - channel->headCache > channel->mask) {
+		channel->headCache = __atomic_load_n(&channel->head, __ATOMIC_ACQUIRE);
+		if (tail - channel->headCache > channel->mask) return 0;
+	}
+
+	// Fill the slot, then publish it
+	channel->ring[tail & channel->mask] = data;
+	__atomic_store_n(&channel->tail, tail + 1, __ATOMIC_RELEASE);
+
+	// Wake the consumer if it went to sleep on an empty ring
+	wake_on(&channel->consumerWaiting);
+	return 1;
+}
+
+void spscSend(SPSCChannel* channel, void* data) {
+	while (1) {
+		for (int spin = 0; spin < SPSC_SPINS; spin++)
+			if (spscTrySend(channel, data)) return;
+
+		// Announce the wait, then look once more before sleeping
+		__atomic_store_n(&channel->producerWaiting, 1, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		uint32_t head = __atomic_load_n(&channel->head, __ATOMIC_ACQUIRE);
+		if (channel->tail - head > channel->mask) wait_on(&channel->producerWaiting);
+		__atomic_store_n(&channel->producerWaiting, 0, __ATOMIC_RELAXED);
+	}
+}
+
+void* spscTryReceive(SPSCChannel* channel) {
+	// Only reread tail when the cached copy says the ring is empty
+	uint32_t head = channel->head;
+	if (head == channel->tailCache) {
+		channel->tailCache = __atomic_load_n(&channel->tail, __ATOMIC_ACQUIRE);
+		if (head == channel->tailCache) return NULL;
+	}
+
+	// Take the slot, then hand it back
+	void* data = channel->ring[head & channel->mask];
+	__atomic_store_n(&channel->head, head + 1, __ATOMIC_RELEASE);
+
+	// Wake the producer if it went to sleep on a full ring
+	wake_on(&channel->producerWaiting);
+	return data;
+}
+
+void* spscReceive(SPSCChannel* channel) {
+	while (1) {
+		for (int spin = 0; spin < SPSC_SPINS; spin++) {
+			void* data = spscTryReceive(channel);
+			if (data != NULL) return data;
+		}
+
+		// Announce the wait, then look once more before sleeping. Closing
+		// only happens after the last send, so closed must be read before
+		// tail: a tail read after seeing closed sees every message, while
+		// one read before could miss a send that came just ahead of the
+		// close.
+		__atomic_store_n(&channel->consumerWaiting, 1, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		int closed = __atomic_load_n(&channel->closed, __ATOMIC_ACQUIRE);
+		if (spscReceiveWindowHook != NULL) spscReceiveWindowHook(channel);
+		uint32_t tail = __atomic_load_n(&channel->tail, __ATOMIC_ACQUIRE);
+		if (tail == channel->head) {
+			if (closed) {
+				__atomic_store_n(&channel->consumerWaiting, 0, __ATOMIC_RELAXED);
+				return NULL;
+			}
+			wait_on(&channel->consumerWaiting);
+		}
+		__atomic_store_n(&channel->consumerWaiting, 0, __ATOMIC_RELAXED);
+	}
+}
+
+void spscClose(SPSCChannel* channel) {
+	__atomic_store_n(&channel->closed, 1, __ATOMIC_RELEASE);
+	wake_on(&channel->consumerWaiting);
+}
@@ -0,0 +1,138 @@
+/** @file spsc_channel.h */
+#ifndef SPSCCHANNEL_H
+#define SPSCCHANNEL_H
+
+#include <stdint.h>
+
+/** The cache line size the channel pads each end to */
+#define SPSC_CACHE_LINE 64
+
+/** Checks of the other end before a blocking call goes to sleep */
+#define SPSC_SPINS 128
+
+
+/********************************************
+ * SPSC channel library functions           *
+ * A bounded single-producer, single-       *
+ * consumer ring of pointers. Each end owns *
+ * one index, so a send or receive is a     *
+ * plain load and a release store, then a   *
+ * full fence and a load of the other end's *
+ * waiting flag so that a wake is never     *
+ * lost. The blocking calls sleep on a      *
+ * futex when the ring is empty or full.    *
+ ********************************************/
+
+
+/**
+ * This structure represents an SPSC channel. The indices run freely and wrap
+ * around at 2^32; a slot is index & mask.
+ */
+typedef struct spscchannel_t {
+    /** The next slot the producer will fill. Producer writes it. */
+    uint32_t tail;
+
+    /** The producer's last look at head, to avoid reading it every send */
+    uint32_t headCache;
+
+    /** 1 while the consumer is asleep or about to sleep. The producer
+        checks it after every send, so it lives on the producer's line; it
+        clears it before waking the consumer, which sleeps on it. */
+    uint32_t consumerWaiting;
+    char tailPad[SPSC_CACHE_LINE - 3 * sizeof(uint32_t)];
+
+    /** The next slot the consumer will empty. Consumer writes it. */
+    uint32_t head;
+
+    /** The consumer's last look at tail */
+    uint32_t tailCache;
+
+    /** 1 while the producer is asleep or about to sleep, used as
+        consumerWaiting is */
+    uint32_t producerWaiting;
+    char headPad[SPSC_CACHE_LINE - 3 * sizeof(uint32_t)];
+
+    /** The slots */
+    void** ring;
+
+    /** The number of slots minus one */
+    uint32_t mask;
+
+    /** 1 once the producer has closed the channel */
+    int closed;
+} SPSCChannel;
+
+
+/**
+ * create_spscchannel
+ *
+ * Creates an empty channel by allocating memory for it on the heap.
+ *
+ * @param capacity The number of messages it can hold, rounded up to a power of two.
+ *                 At most 2^31.
+ * @return A pointer to the channel, or NULL if the capacity is too large or
+ *         allocation failed
+ */
+SPSCChannel* create_spscchannel(uint32_t capacity);
+
+/**
+ * destroySPSCChannel
+ *
+ * Destroy the channel. Messages still in it are not freed.
+ *
+ * @param channel A pointer to the channel
+ */
+void destroySPSCChannel(SPSCChannel* channel);
+
+/**
+ * spscTrySend
+ *
+ * Put a message in the channel if there is room. Producer only.
+ *
+ * @param channel A pointer to the channel
+ * @param data The message. Must not be NULL.
+ * @return 1 if the message was sent
+ *         0 if the channel is full
+ */
+int spscTrySend(SPSCChannel* channel, void* data);
+
+/**
+ * spscSend
+ *
+ * Put a message in the channel, sleeping while it is full. Producer only.
+ *
+ * @param channel A pointer to the channel
+ * @param data The message. Must not be NULL.
+ */
+void spscSend(SPSCChannel* channel, void* data);
+
+/**
+ * spscTryReceive
+ *
+ * Take the oldest message if there is one. Consumer only.
+ *
+ * @param channel A pointer to the channel
+ * @return the message, or NULL if the channel is empty
+ */
+void* spscTryReceive(SPSCChannel* channel);
+
+/**
+ * spscReceive
+ *
+ * Take the oldest message, sleeping while the channel is empty. Consumer only.
+ *
+ * @param channel A pointer to the channel
+ * @return the message, or NULL once the channel is closed and empty
+ */
+void* spscReceive(SPSCChannel* channel);
+
+/**
+ * spscClose
+ *
+ * Mark the channel closed and wake the consumer. Producer only; nothing may
+ * be sent afterwards.
+ *
+ * @param channel A pointer to the channel
+ */
+void spscClose(SPSCChannel* channel);
+#endif
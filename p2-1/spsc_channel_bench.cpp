@@ -0,0 +1,114 @@
+// The SPSC channel against a DLinkedList guarded by a mutex and condition
+// variable, handing messages from one thread to another
+//
+// Usage: ./spsc_channel_bench [messages] [capacity]
+//
+// "polling" uses the non-blocking ends and yields when they fail; "blocking"
+// uses the futex-backed ends. Throughput counts messages delivered.
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "doublely_linked_list.h"
+#include "spsc_channel.h"
+
+struct Workload {
+	SPSCChannel* channel;
+	DLinkedList* list;
+	pthread_mutex_t mutex;
+	pthread_cond_t ready;
+	long messages;
+	uintptr_t sink;
+};
+
+static void* polling_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	if (t->index == 0) {
+		for (uintptr_t i = 1; i <= (uintptr_t) w->messages; i++)
+			while (!spscTrySend(w->channel, (void*) i)) sched_yield();
+		return NULL;
+	}
+	uintptr_t sum = 0;
+	for (long received = 0; received < w->messages; ) {
+		void* d = spscTryReceive(w->channel);
+		if (d == NULL) {
+			sched_yield();
+			continue;
+		}
+		sum += (uintptr_t) d;
+		received++;
+	}
+	w->sink = sum;
+	return NULL;
+}
+
+static void* blocking_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	if (t->index == 0) {
+		for (uintptr_t i = 1; i <= (uintptr_t) w->messages; i++)
+			spscSend(w->channel, (void*) i);
+		return NULL;
+	}
+	uintptr_t sum = 0;
+	for (long received = 0; received < w->messages; received++)
+		sum += (uintptr_t) spscReceive(w->channel);
+	w->sink = sum;
+	return NULL;
+}
+
+static void* condvar_body(BenchThread* t)
+{
+	Workload* w = (Workload*) t->arg;
+	if (t->index == 0) {
+		for (uintptr_t i = 1; i <= (uintptr_t) w->messages; i++) {
+			pthread_mutex_lock(&w->mutex);
+			insertTail(w->list, (void*) i);
+			pthread_cond_signal(&w->ready);
+			pthread_mutex_unlock(&w->mutex);
+		}
+		return NULL;
+	}
+	uintptr_t sum = 0;
+	for (long received = 0; received < w->messages; received++) {
+		pthread_mutex_lock(&w->mutex);
+		while (getHead(w->list) == NULL) pthread_cond_wait(&w->ready, &w->mutex);
+		sum += (uintptr_t) removeForward(w->list);
+		pthread_mutex_unlock(&w->mutex);
+	}
+	w->sink = sum;
+	return NULL;
+}
+
+int main(int argc, char** argv)
+{
+	Workload w;
+	w.messages = argc > 1 ? atol(argv[1]) : 10000000;
+	uint32_t capacity = argc > 2 ? atoi(argv[2]) : 1024;
+	pthread_mutex_init(&w.mutex, NULL);
+	pthread_cond_init(&w.ready, NULL);
+	char name[64];
+
+	w.channel = create_spscchannel(capacity);
+	double seconds = benchRunThreads(2, polling_body, &w);
+	snprintf(name, sizeof(name), "channel polling  capacity=%u", w.channel->mask + 1);
+	benchReport(name, w.messages, seconds);
+	destroySPSCChannel(w.channel);
+
+	w.channel = create_spscchannel(capacity);
+	seconds = benchRunThreads(2, blocking_body, &w);
+	snprintf(name, sizeof(name), "channel blocking capacity=%u", w.channel->mask + 1);
+	benchReport(name, w.messages, seconds);
+	destroySPSCChannel(w.channel);
+
+	w.list = create_dlinkedlist();
+	seconds = benchRunThreads(2, condvar_body, &w);
+	benchReport("list mutex+condvar", w.messages, seconds);
+	destroyList(w.list);
+
+	pthread_cond_destroy(&w.ready);
+	pthread_mutex_destroy(&w.mutex);
+	return w.sink == 0;
+}
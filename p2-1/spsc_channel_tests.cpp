@@ -0,0 +1,108 @@
+#include <pthread.h>
+#include <stdint.h>
+#include "spsc_channel.h"
+#include "gtest/gtest.h"
+
+
+#define MESSAGES 200000
+
+// Sends 1..MESSAGES through a small channel, then closes it
+static void* producer_thread(void* arg)
+{
+	SPSCChannel* channel = (SPSCChannel*) arg;
+	for (uintptr_t i = 1; i <= MESSAGES; i++)
+		spscSend(channel, (void*) i);
+	spscClose(channel);
+	return NULL;
+}
+
+// The hook spscReceive calls between reading closed and reading tail
+extern void (*spscReceiveWindowHook)(SPSCChannel* channel);
+
+// Sends one message and closes, from inside that window, once
+static void send_and_close(SPSCChannel* channel)
+{
+	spscReceiveWindowHook = NULL;
+	spscSend(channel, (void*) 42);
+	spscClose(channel);
+}
+
+
+TEST(SPSCChannel, FullAndEmpty)
+{
+	SPSCChannel* channel = create_spscchannel(3);
+	ASSERT_TRUE(channel != NULL);
+	EXPECT_EQ(3u, channel->mask);
+	EXPECT_EQ(NULL, spscTryReceive(channel));
+	EXPECT_EQ(NULL, create_spscchannel((UINT32_C(1) << 31) + 1));
+
+	// Four fit, the fifth does not
+	for (uintptr_t i = 1; i <= 4; i++)
+		ASSERT_EQ(1, spscTrySend(channel, (void*) i));
+	EXPECT_EQ(0, spscTrySend(channel, (void*) 5));
+
+	// They come out in order, and room opens up as they do
+	EXPECT_EQ((void*) 1, spscTryReceive(channel));
+	EXPECT_EQ(1, spscTrySend(channel, (void*) 5));
+	for (uintptr_t i = 2; i <= 5; i++)
+		EXPECT_EQ((void*) i, spscTryReceive(channel));
+	EXPECT_EQ(NULL, spscTryReceive(channel));
+
+	destroySPSCChannel(channel);
+}
+
+TEST(SPSCChannel, IndicesWrap)
+{
+	SPSCChannel* channel = create_spscchannel(4);
+
+	// Start just short of 2^32 so the free-running indices overflow
+	channel->head = channel->tail = channel->headCache = channel->tailCache = UINT32_MAX - 2;
+	for (uintptr_t i = 1; i <= 20; i++) {
+		ASSERT_EQ(1, spscTrySend(channel, (void*) i));
+		ASSERT_EQ((void*) i, spscTryReceive(channel));
+	}
+	for (uintptr_t i = 1; i <= 4; i++)
+		ASSERT_EQ(1, spscTrySend(channel, (void*) i));
+	EXPECT_EQ(0, spscTrySend(channel, (void*) 5));
+
+	destroySPSCChannel(channel);
+}
+
+TEST(SPSCChannel, ClosedAndEmptyReturnsNull)
+{
+	SPSCChannel* channel = create_spscchannel(4);
+	spscSend(channel, (void*) 1);
+	spscClose(channel);
+	EXPECT_EQ((void*) 1, spscReceive(channel));
+	EXPECT_EQ(NULL, spscReceive(channel));
+	destroySPSCChannel(channel);
+}
+
+TEST(SPSCChannel, BlockingEnds)
+{
+	// A tiny channel makes both ends block often
+	SPSCChannel* channel = create_spscchannel(8);
+	pthread_t producer;
+	pthread_create(&producer, NULL, producer_thread, channel);
+
+	uintptr_t expected = 1;
+	for (void* d; (d = spscReceive(channel)) != NULL; expected++)
+		ASSERT_EQ((void*) expected, d);
+	EXPECT_EQ((uintptr_t) MESSAGES + 1, expected);
+
+	pthread_join(producer, NULL);
+	destroySPSCChannel(channel);
+}
+
+TEST(SPSCChannel, CloseInsideReceiveWindow)
+{
+	// The last message and the close land after spscReceive has looked at
+	// closed but before it looks at tail. It must still get the message.
+	SPSCChannel* channel = create_spscchannel(4);
+	spscReceiveWindowHook = send_and_close;
+	EXPECT_EQ((void*) 42, spscReceive(channel));
+	EXPECT_EQ(NULL, spscReceive(channel));
+	EXPECT_EQ(NULL, spscTryReceive(channel));
+	spscReceiveWindowHook = NULL;
+	destroySPSCChannel(channel);
+}
@@ -0,0 +1,71 @@
+/** @file static_list.h */
+#ifndef STATICLIST_H
+#define STATICLIST_H
+
+#include <stddef.h>
+#include "policy_list.h"
+
+
+/********************************************
+ * Static list library                      *
+ * A fixed-capacity list for builds that    *
+ * must not touch the heap. Its nodes live  *
+ * in an array inside the list, and a free  *
+ * chain through that array makes taking    *
+ * and giving back a node O(1). Once every  *
+ * node is in use, inserts fail with 0.     *
+ ********************************************/
+
+
+/**
+ * An allocator policy that hands out nodes from an array of N inside the
+ * policy itself. It cannot be copied, since the free chain points into its own
+ * array.
+ */
+template <int N>
+struct StaticNodes {
+    /** Every node the list can ever hold */
+    LLNode nodes[N];
+
+    /** Nodes not in the list, chained through next */
+    LLNode* spare;
+
+    /** The number of nodes in spare */
+    int available;
+
+    StaticNodes() : spare(NULL), available(N) {
+        for (int i = N - 1; i >= 0; i--) {
+            nodes[i].next = spare;
+            spare = &nodes[i];
+        }
+    }
+
+    StaticNodes(const StaticNodes&) = delete;
+    StaticNodes& operator=(const StaticNodes&) = delete;
+
+    LLNode* allocate() {
+        if (spare == NULL) return NULL;
+        LLNode* node = spare;
+        spare = node->next;
+        available--;
+        return node;
+    }
+
+    void deallocate(LLNode* node) {
+        node->next = spare;
+        spare = node;
+        available++;
+    }
+};
+
+/**
+ * A doublely linked list of at most N nodes that never calls malloc. It has
+ * the PolicyList function surface, which mirrors DLinkedList's; declare it
+ * static or on the stack:
+ *
+ *     static StaticDLinkedList<32> pending;
+ *     if (!pending.insertTail(event)) ... the list is full
+ */
+template <int N>
+using StaticDLinkedList = PolicyList<StaticNodes<N>, NoLock, CountSize>;
+#endif
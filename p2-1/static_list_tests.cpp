@@ -0,0 +1,54 @@
+#include <stdint.h>
+#include "static_list.h"
+#include "gtest/gtest.h"
+
+
+#define CAPACITY 8
+
+// True if the node is one of the list's own
+template <typename L>
+static bool owns(L& list, LLNode* node)
+{
+	return (char*) node >= (char*) &list && (char*) node < (char*) (&list + 1);
+}
+
+
+TEST(StaticList, FullListRefusesInserts)
+{
+	StaticDLinkedList<CAPACITY> list;
+	for (uintptr_t i = 1; i <= CAPACITY; i++) ASSERT_EQ(1, list.insertTail((void*) i));
+	EXPECT_EQ(0, list.allocator().available);
+
+	// Every kind of insert fails without changing the list
+	list.getHead();
+	EXPECT_EQ(0, list.insertHead((void*) 99));
+	EXPECT_EQ(0, list.insertTail((void*) 99));
+	EXPECT_EQ(0, list.insertAfter((void*) 99));
+	EXPECT_EQ(0, list.insertBefore((void*) 99));
+	EXPECT_EQ(CAPACITY, list.getSize());
+	EXPECT_EQ((void*) CAPACITY, list.getTail());
+
+	// Every node is inside the list object, so none came from the heap
+	for (LLNode* node = list.head; node != NULL; node = node->next) EXPECT_TRUE(owns(list, node));
+
+	// Removing a node makes room again, and the same slot is reused
+	list.getHead();
+	LLNode* freed = list.current;
+	list.removeForward();
+	EXPECT_EQ(1, list.allocator().available);
+	EXPECT_EQ(1, list.insertHead((void*) 100));
+	EXPECT_EQ(freed, list.head);
+	EXPECT_EQ(0, list.insertHead((void*) 101));
+}
+
+TEST(StaticList, ChurnNeverRunsOut)
+{
+	StaticDLinkedList<CAPACITY> list;
+	for (int round = 0; round < 1000; round++) {
+		for (uintptr_t i = 0; i < CAPACITY; i++) ASSERT_EQ(1, list.insertTail((void*) (i + 1)));
+		list.getHead();
+		while (list.getCurrent() != NULL) list.removeForward();
+	}
+	EXPECT_EQ(0, list.getSize());
+	EXPECT_EQ(CAPACITY, list.allocator().available);
+}
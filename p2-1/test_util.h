@@ -0,0 +1,26 @@
+/** @file test_util.h */
+#ifndef TESTUTIL_H
+#define TESTUTIL_H
+
+#include "doublely_linked_list.h"
+
+
+/********************************************
+ * Test helpers                             *
+ * Shared by the *_tests.cpp suites.        *
+ ********************************************/
+
+
+/**
+ * testDrain
+ *
+ * Remove every node from a list without freeing the data, which tests borrow
+ * or fake, so the list can be destroyed
+ *
+ * @param list A pointer to the list
+ */
+static inline void testDrain(DLinkedList* list) {
+    getHead(list);
+    while (getCurrent(list) != NULL) removeForward(list);
+}
+#endif
@@ -0,0 +1,117 @@
+// A hierarchical timer wheel with doublely-linked list slots
+
+#include <stdlib.h>
+#include "timer_wheel.h"
+
+#define TW_SLOT_MASK (TW_SLOTS - 1)
+
+// Link a timer into the lowest wheel whose span reaches its expiry. A timer
+// in wheel L moves down when the time reaches the start of its slot.
+static void place_timer(TimerWheel* wheel, WheelTimer* timer) {
+	for (int level = 0; level < TW_LEVELS; level++) {
+		int shift = level * TW_SLOT_BITS;
+		if ((timer->expires >> shift) - (wheel->now >> shift) < TW_SLOTS) {
+			timer->slot = &wheel->slots[level][(timer->expires >> shift) & TW_SLOT_MASK];
+			insertNodeTail(timer->slot, &timer->node);
+			return;
+		}
+	}
+
+	// Too far out for any wheel: park it in the top wheel's last slot, and
+	// place it again when that slot comes around
+	int shift = (TW_LEVELS - 1) * TW_SLOT_BITS;
+	timer->slot = &wheel->slots[TW_LEVELS - 1][((wheel->now >> shift) + TW_SLOTS - 1) & TW_SLOT_MASK];
+	insertNodeTail(timer->slot, &timer->node);
+}
+
+// Move every timer in a slot down to the wheel its expiry now falls in
+static void cascade(TimerWheel* wheel, int level) {
+	DLinkedList* slot = &wheel->slots[level][(wheel->now >> (level * TW_SLOT_BITS)) & TW_SLOT_MASK];
+	while (slot->head != NULL) place_timer(wheel, (WheelTimer *) detachNode(slot, slot->head));
+}
+
+TimerWheel* create_timerwheel(void) {
+	// An all-zero DLinkedList is an empty list, so calloc gives empty slots
+	TimerWheel* wheel = (TimerWheel *) calloc(1, sizeof(TimerWheel));
+	return wheel;
+}
+
+void destroyTimerWheel(TimerWheel* wheel) {
+	// Free every pending timer in every slot
+	for (int level = 0; level < TW_LEVELS; level++) {
+		for (int i = 0; i < TW_SLOTS; i++) {
+			LLNode* node = wheel->slots[level][i].head;
+			while (node != NULL) {
+				LLNode* next = node->next;
+				free(node);
+				node = next;
+			}
+		}
+	}
+
+	// Free up the wheel's memory
+	free(wheel);
+}
+
+WheelTimer* timerSchedule(TimerWheel* wheel, uint64_t delay, void* data) {
+	// Create the handle
+	WheelTimer* timer = (WheelTimer *) malloc(sizeof(WheelTimer));
+	if (timer == NULL) return NULL;
+	timer->node.data = data;
+	timer->expires = wheel->now + (delay == 0 ? 1 : delay);
+
+	// Link it into its slot
+	place_timer(wheel, timer);
+	wheel->count++;
+	return timer;
+}
+
+void* timerCancel(TimerWheel* wheel, WheelTimer* timer) {
+	// Unlink and free the handle
+	void* data = timer->node.data;
+	detachNode(timer->slot, &timer->node);
+	free(timer);
+	wheel->count--;
+	return data;
+}
+
+int timerWheelAdvance(TimerWheel* wheel, uint64_t ticks, TimerExpireFn expire, void* context) {
+	int fired = 0;
+	while (ticks-- > 0) {
+		// With nothing pending there is nothing to cascade or fire
+		if (wheel->count == 0) {
+			wheel->now += ticks + 1;
+			break;
+		}
+		wheel->now++;
+
+		// Cascade every wheel whose slot boundary we just crossed, top down,
+		// so timers can fall more than one wheel in a single tick
+		int level = 1;
+		while (level < TW_LEVELS && (wheel->now & (((uint64_t) 1 << (level * TW_SLOT_BITS)) - 1)) == 0) level++;
+		while (--level > 0) cascade(wheel, level);
+
+		// Fire everything due this tick
+		DLinkedList* slot = &wheel->slots[0][wheel->now & TW_SLOT_MASK];
+		while (slot->head != NULL) {
+			WheelTimer* timer = (WheelTimer *) detachNode(slot, slot->head);
+			wheel->count--;
+			fired++;
+			uint64_t again = expire(timer->node.data, context);
+			if (again == 0) {
+				free(timer);
+				continue;
+			}
+
+			// Re-arm periodic timers without reallocating them
+			timer->expires = wheel->now + again;
+			place_timer(wheel, timer);
+			wheel->count++;
+		}
+	}
+	return fired;
+}
+
+int timerCount(TimerWheel* wheel) {
+	return wheel->count;
+}
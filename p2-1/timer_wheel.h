@@ -0,0 +1,135 @@
+/** @file timer_wheel.h */
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <stdint.h>
+#include "doublely_linked_list.h"
+
+/** The number of wheels in the hierarchy */
+#define TW_LEVELS 4
+
+/** log2 of the number of slots per wheel */
+#define TW_SLOT_BITS 6
+
+/** The number of slots per wheel */
+#define TW_SLOTS (1 << TW_SLOT_BITS)
+
+
+/********************************************
+ * Timer wheel library functions            *
+ * A hierarchical timing wheel whose slots  *
+ * are doublely linked lists. Scheduling    *
+ * and cancelling are O(1), and each tick   *
+ * does amortized O(1) work per timer.      *
+ ********************************************/
+
+
+/**
+ * This structure represents a pending timer. It is the handle returned by
+ * timerSchedule. The node's data pointer is the caller's data.
+ */
+typedef struct wheeltimer_t {
+    /** The node linking this timer into its slot. Must be first. */
+    LLNode node;
+
+    /** The tick the timer expires at */
+    uint64_t expires;
+
+    /** The slot the timer is linked into */
+    DLinkedList* slot;
+} WheelTimer;
+
+/**
+ * This structure represents an entire timer wheel. Wheel 0 holds timers due
+ * within the next TW_SLOTS ticks, one slot per tick. Each higher wheel covers
+ * TW_SLOTS times the span of the one below, and its timers move down a wheel
+ * when the time reaches their slot.
+ */
+typedef struct timerwheel_t {
+    /** The slots of every wheel */
+    DLinkedList slots[TW_LEVELS][TW_SLOTS];
+
+    /** The current tick */
+    uint64_t now;
+
+    /** The number of pending timers */
+    int count;
+} TimerWheel;
+
+/**
+ * Callback invoked for each timer that expires.
+ *
+ * @param data The timer's data pointer
+ * @param context The context pointer given to timerWheelAdvance
+ * @return the number of ticks until the timer should fire again, or 0 to
+ *         free the timer
+ */
+typedef uint64_t (*TimerExpireFn)(void* data, void* context);
+
+
+/**
+ * create_timerwheel
+ *
+ * Creates an empty timer wheel at tick 0 by allocating memory for it on the heap.
+ *
+ * @return A pointer to an empty timer wheel, or NULL if allocation failed
+ */
+TimerWheel* create_timerwheel(void);
+
+/**
+ * destroyTimerWheel
+ *
+ * Destroy the timer wheel and every pending timer. The data is not freed.
+ *
+ * @param wheel A pointer to the timer wheel
+ */
+void destroyTimerWheel(TimerWheel* wheel);
+
+/**
+ * timerSchedule
+ *
+ * Schedule data to expire after a number of ticks. Delays longer than the
+ * wheels can hold are parked in the top wheel and re-placed as time passes.
+ *
+ * @param wheel A pointer to the timer wheel
+ * @param delay The number of ticks until the timer expires. 0 is treated as 1.
+ * @param data A void pointer to the data to hand back on expiry
+ * @return the timer's handle, or NULL if allocation failed
+ */
+WheelTimer* timerSchedule(TimerWheel* wheel, uint64_t delay, void* data);
+
+/**
+ * timerCancel
+ *
+ * Cancel a pending timer and free its handle.
+ *
+ * @param wheel A pointer to the timer wheel
+ * @param timer The handle returned by timerSchedule
+ * @return the timer's data
+ */
+void* timerCancel(TimerWheel* wheel, WheelTimer* timer);
+
+/**
+ * timerWheelAdvance
+ *
+ * Advance time tick by tick, calling the callback for every timer that
+ * expires. The callback may schedule and cancel other timers.
+ *
+ * @param wheel A pointer to the timer wheel
+ * @param ticks The number of ticks to advance
+ * @param expire Called for each expired timer
+ * @param context Passed through to expire
+ * @return the number of timers that expired
+ */
+int timerWheelAdvance(TimerWheel* wheel, uint64_t ticks, TimerExpireFn expire, void* context);
+
+/**
+ * timerCount
+ *
+ * Return the number of pending timers
+ *
+ * @param wheel A pointer to the timer wheel
+ * @return the number of pending timers
+ */
+int timerCount(TimerWheel* wheel);
+#endif
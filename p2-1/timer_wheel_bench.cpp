@@ -0,0 +1,109 @@
+// The timer wheel against a DLinkedList kept sorted by expiry
+//
+// Usage: ./timer_wheel_bench [largest timer count] [largest sorted-list count]
+//
+// The sorted list pays an O(n) scan per schedule and cancel, so it is only run
+// up to the second (smaller) limit.
+
+#include <stdlib.h>
+#include "bench_util.h"
+#include "doublely_linked_list.h"
+#include "timer_wheel.h"
+
+#define MAX_DELAY 65536
+
+struct Event {
+	uint64_t expires;
+	WheelTimer* handle;
+};
+
+static uint64_t count_fire(void* data, void* context)
+{
+	(void) data;
+	(*(int*) context)++;
+	return 0;
+}
+
+static void run_wheel(Event* events, size_t n)
+{
+	char name[64];
+	TimerWheel* wheel = create_timerwheel();
+
+	double start = benchSeconds();
+	for (size_t i = 0; i < n; i++)
+		events[i].handle = timerSchedule(wheel, events[i].expires, &events[i]);
+	snprintf(name, sizeof(name), "wheel  schedule n=%zu", n);
+	benchReport(name, n, benchSeconds() - start);
+
+	start = benchSeconds();
+	for (size_t i = 0; i < n; i += 2)
+		timerCancel(wheel, events[i].handle);
+	snprintf(name, sizeof(name), "wheel  cancel   n=%zu", n);
+	benchReport(name, n / 2, benchSeconds() - start);
+
+	int fired = 0;
+	start = benchSeconds();
+	timerWheelAdvance(wheel, MAX_DELAY, count_fire, &fired);
+	snprintf(name, sizeof(name), "wheel  expire   n=%zu", n);
+	benchReport(name, fired, benchSeconds() - start);
+
+	destroyTimerWheel(wheel);
+}
+
+static void run_sorted(Event* events, size_t n)
+{
+	char name[64];
+	DLinkedList* list = create_dlinkedlist();
+
+	// Scan for the first later event and insert before it
+	double start = benchSeconds();
+	for (size_t i = 0; i < n; i++) {
+		Event* e = (Event*) getHead(list);
+		while (e != NULL && e->expires <= events[i].expires)
+			e = (Event*) getNext(list);
+		if (e == NULL) insertTail(list, &events[i]);
+		else insertBefore(list, &events[i]);
+	}
+	snprintf(name, sizeof(name), "sorted schedule n=%zu", n);
+	benchReport(name, n, benchSeconds() - start);
+
+	start = benchSeconds();
+	for (size_t i = 0; i < n; i += 2)
+		removeByData(list, &events[i]);
+	snprintf(name, sizeof(name), "sorted cancel   n=%zu", n);
+	benchReport(name, n / 2, benchSeconds() - start);
+
+	// Pop due events off the head, tick by tick
+	int fired = 0;
+	start = benchSeconds();
+	for (uint64_t now = 1; now <= MAX_DELAY; now++) {
+		Event* e = (Event*) getHead(list);
+		while (e != NULL && e->expires <= now) {
+			removeForward(list);
+			fired++;
+			e = (Event*) getCurrent(list);
+		}
+	}
+	snprintf(name, sizeof(name), "sorted expire   n=%zu", n);
+	benchReport(name, fired, benchSeconds() - start);
+
+	destroyList(list);
+}
+
+int main(int argc, char** argv)
+{
+	size_t largest = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000;
+	size_t largestSorted = argc > 2 ? strtoul(argv[2], NULL, 10) : 10000;
+	uint64_t rng = 88172645463325252ULL;
+
+	for (size_t n = 1000; n <= largest; n *= 10) {
+		Event* events = (Event*) malloc(n * sizeof(Event));
+		for (size_t i = 0; i < n; i++)
+			events[i].expires = 1 + benchRandom(&rng) % (MAX_DELAY - 1);
+
+		run_wheel(events, n);
+		if (n <= largestSorted) run_sorted(events, n);
+		free(events);
+	}
+	return 0;
+}
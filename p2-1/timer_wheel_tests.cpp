@@ -0,0 +1,87 @@
+#include "timer_wheel.h"
+#include "gtest/gtest.h"
+
+
+// Records the tick each expired timer fired at. The data points at the
+// slot to record into.
+struct FireLog {
+	TimerWheel* wheel;
+	uint64_t rearm;
+	int fired;
+};
+
+static uint64_t record_fire(void* data, void* context)
+{
+	FireLog* log = (FireLog*) context;
+	*(uint64_t*) data = log->wheel->now;
+	log->fired++;
+	return log->rearm;
+}
+
+
+TEST(TimerWheel, CreateDestroy)
+{
+	TimerWheel* wheel = create_timerwheel();
+	ASSERT_TRUE(wheel != NULL);
+	EXPECT_EQ(0, timerCount(wheel));
+	destroyTimerWheel(wheel);
+}
+
+TEST(TimerWheel, FiresOnTime)
+{
+	// Delays that land in every wheel, including one past the top wheel
+	uint64_t delays[] = {1, 5, 63, 64, 65, 4095, 4096, 70000, 300000, 20000000};
+	size_t num_timers = sizeof(delays) / sizeof(delays[0]);
+	uint64_t fired_at[10] = {0};
+
+	TimerWheel* wheel = create_timerwheel();
+	FireLog log = {wheel, 0, 0};
+	timerWheelAdvance(wheel, 3, record_fire, &log);
+	for (size_t i = 0; i < num_timers; i++)
+		ASSERT_TRUE(timerSchedule(wheel, delays[i], &fired_at[i]) != NULL);
+	EXPECT_EQ((int) num_timers, timerCount(wheel));
+
+	// Advance in uneven steps past the last expiry
+	while (timerCount(wheel) > 0)
+		timerWheelAdvance(wheel, 997, record_fire, &log);
+	EXPECT_EQ((int) num_timers, log.fired);
+	for (size_t i = 0; i < num_timers; i++)
+		EXPECT_EQ(3 + delays[i], fired_at[i]);
+
+	destroyTimerWheel(wheel);
+}
+
+TEST(TimerWheel, Cancel)
+{
+	uint64_t fired_at[3] = {0};
+	TimerWheel* wheel = create_timerwheel();
+	FireLog log = {wheel, 0, 0};
+	WheelTimer* timers[3];
+	for (int i = 0; i < 3; i++)
+		timers[i] = timerSchedule(wheel, 100, &fired_at[i]);
+
+	// Cancelling hands back the data and the timer never fires
+	EXPECT_EQ(&fired_at[1], timerCancel(wheel, timers[1]));
+	EXPECT_EQ(2, timerCount(wheel));
+	EXPECT_EQ(2, timerWheelAdvance(wheel, 100, record_fire, &log));
+	EXPECT_EQ(100u, fired_at[0]);
+	EXPECT_EQ(0u, fired_at[1]);
+	EXPECT_EQ(100u, fired_at[2]);
+
+	destroyTimerWheel(wheel);
+}
+
+TEST(TimerWheel, Rearm)
+{
+	uint64_t fired_at = 0;
+	TimerWheel* wheel = create_timerwheel();
+	FireLog log = {wheel, 10, 0};
+	timerSchedule(wheel, 10, &fired_at);
+
+	// A periodic timer stays pending and fires every 10 ticks
+	EXPECT_EQ(5, timerWheelAdvance(wheel, 55, record_fire, &log));
+	EXPECT_EQ(50u, fired_at);
+	EXPECT_EQ(1, timerCount(wheel));
+
+	destroyTimerWheel(wheel);
+}
@@ -0,0 +1,71 @@
+// Small payloads stored behind void* (a malloc per payload plus a node)
+// against value nodes that hold the payload in the node: building, walking
+// and destroying a list, for 16, 32 and 64 byte payloads
+//
+// Usage: ./value_list_bench [elements]
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_util.h"
+#include "doublely_linked_list.h"
+
+static void run(long n, size_t size, uint64_t* sums)
+{
+	unsigned char payload[64] = {0};
+	char name[64];
+
+	// One allocation for the payload and one for the node
+	double begin = benchSeconds();
+	DLinkedList* list = create_dlinkedlist();
+	for (long i = 0; i < n; i++) {
+		memcpy(payload, &i, sizeof(i));
+		void* copy = malloc(size);
+		memcpy(copy, payload, size);
+		insertTail(list, copy);
+	}
+	double built = benchSeconds();
+	for (int pass = 0; pass < 4; pass++)
+		for (void* d = getHead(list); d != NULL; d = getNext(list)) sums[0] += *(uint64_t*) d;
+	double walked = benchSeconds();
+	destroyList(list);
+	double destroyed = benchSeconds();
+	snprintf(name, sizeof(name), "pointer %2zu bytes build", size);
+	benchReport(name, n, built - begin);
+	snprintf(name, sizeof(name), "pointer %2zu bytes walk", size);
+	benchReport(name, 4.0 * n, walked - built);
+	snprintf(name, sizeof(name), "pointer %2zu bytes destroy", size);
+	benchReport(name, n, destroyed - walked);
+
+	// One allocation holding both
+	begin = benchSeconds();
+	list = create_dlinkedlist();
+	for (long i = 0; i < n; i++) {
+		memcpy(payload, &i, sizeof(i));
+		insertTailValue(list, payload, size);
+	}
+	built = benchSeconds();
+	for (int pass = 0; pass < 4; pass++)
+		for (void* d = getHead(list); d != NULL; d = getNext(list)) sums[1] += *(uint64_t*) d;
+	walked = benchSeconds();
+	destroyList(list);
+	destroyed = benchSeconds();
+	snprintf(name, sizeof(name), "value   %2zu bytes build", size);
+	benchReport(name, n, built - begin);
+	snprintf(name, sizeof(name), "value   %2zu bytes walk", size);
+	benchReport(name, 4.0 * n, walked - built);
+	snprintf(name, sizeof(name), "value   %2zu bytes destroy", size);
+	benchReport(name, n, destroyed - walked);
+}
+
+int main(int argc, char** argv)
+{
+	long n = argc > 1 ? atol(argv[1]) : 1000000;
+	uint64_t sums[2] = {0, 0};
+	run(n, 16, sums);
+	run(n, 32, sums);
+	run(n, 64, sums);
+
+	// Both sides walked the same payloads
+	return sums[0] != sums[1];
+}